@@ -0,0 +1,164 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <memory_resource>
+#include "general_list.hpp"
+#include "list.h"
+
+// 基准：general::list 与 std::list、C 的 List 对比
+// 同一组随机整数依次做尾插、遍历求和、未命中查找、排序、逐个头删
+// C 的 List 每个元素另行 malloc 数据，比较经 cmp 函数指针；general::list 元素直接存放在节点内
+// 用法: ./bench_list_cpp [元素数 ...]，默认 1000000
+
+#define SEARCH_ROUNDS 10
+
+static uint64_t next_random(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static double elapsed_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static int int_cmp(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+struct Timings {
+    double push;
+    double sum;
+    double search;
+    double sort;
+    double pop;
+    long long checksum;
+};
+
+static void print_row(const char *name, const Timings &t) {
+    printf("%-24s 尾插 %7.3f  遍历 %7.3f  查找 %7.3f  排序 %7.3f  头删 %7.3f  合计 %7.3f秒  (%lld)\n", name,
+           t.push, t.sum, t.search, t.sort, t.pop, t.push + t.sum + t.search + t.sort + t.pop, t.checksum);
+}
+
+// general::list 与 std::list 接口相同，用同一份代码
+template <class ListType>
+static Timings run_std_like(ListType &list, const int *values, size_t count) {
+    Timings t = {};
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; i++) {
+        list.emplace_back(values[i]);
+    }
+    t.push = elapsed_since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int v : list) {
+        t.checksum += v;
+    }
+    t.sum = elapsed_since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < SEARCH_ROUNDS; round++) {
+        int key = -1 - round;
+        for (int v : list) {
+            if (v == key) {
+                t.checksum++;
+                break;
+            }
+        }
+    }
+    t.search = elapsed_since(start);
+
+    start = std::chrono::steady_clock::now();
+    list.sort();
+    t.sort = elapsed_since(start);
+    t.checksum += list.front();
+
+    start = std::chrono::steady_clock::now();
+    while (!list.empty()) {
+        list.pop_front();
+    }
+    t.pop = elapsed_since(start);
+    return t;
+}
+
+static Timings run_c_list(const int *values, size_t count) {
+    Timings t = {};
+    List *list = init_list(int_cmp, free);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; i++) {
+        int *data = (int *)malloc(sizeof(int));
+        *data = values[i];
+        insert_at_tail(list, data);
+    }
+    t.push = elapsed_since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (ListNode *node = get_first_node(list); node; node = get_next_node(list, node)) {
+        t.checksum += *(int *)node->data;
+    }
+    t.sum = elapsed_since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < SEARCH_ROUNDS; round++) {
+        int key = -1 - round;
+        if (search_by_value(list, &key)) t.checksum++;
+    }
+    t.search = elapsed_since(start);
+
+    start = std::chrono::steady_clock::now();
+    sort_list(list);
+    t.sort = elapsed_since(start);
+    t.checksum += *(int *)get_first_node(list)->data;
+
+    start = std::chrono::steady_clock::now();
+    while (!is_empty(list)) {
+        delete_at_head(list);
+    }
+    t.pop = elapsed_since(start);
+
+    destroy_list(list);
+    return t;
+}
+
+static void run_size(size_t count) {
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+    int *values = (int *)malloc(count * sizeof(int));
+    for (size_t i = 0; i < count; i++) {
+        values[i] = (int)(next_random(&state) % 1000000000);
+    }
+    printf("\n%zu 个元素（查找为 %d 次未命中）\n", count, SEARCH_ROUNDS);
+
+    {
+        general::list<int> list;
+        print_row("general::list", run_std_like(list, values, count));
+    }
+    {
+        std::pmr::unsynchronized_pool_resource pool;
+        general::pmr::list<int> list(&pool);
+        print_row("general::pmr::list", run_std_like(list, values, count));
+    }
+    {
+        std::list<int> list;
+        print_row("std::list", run_std_like(list, values, count));
+    }
+    print_row("C List", run_c_list(values, count));
+
+    free(values);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 1) {
+        for (int i = 1; i < argc; i++) {
+            size_t count = strtoul(argv[i], NULL, 10);
+            if (count > 0) run_size(count);
+        }
+    } else {
+        run_size(1000000);
+    }
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "list.h"
+
+// 基准：归并排序（list->cmp）与基数排序（sort_list_by_key / sort_list_by_bytes）
+// 每种算法都在新建的链表上运行，链表不持有数据，数据来自同一个数组
+// 用法: ./bench_sort [元素数 ...]，默认 1000000 10000000
+
+#define STR_KEY_BYTES 16
+
+static int u64_cmp(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t u64_key(const void *data) {
+    return *(const uint64_t *)data;
+}
+
+static int str_cmp(const void *a, const void *b) {
+    return strcmp((const char *)a, (const char *)b);
+}
+
+static const void *str_key(const void *data, size_t *length) {
+    *length = strlen((const char *)data);
+    return data;
+}
+
+static uint64_t next_random(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static double elapsed_since(struct timespec start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+static List *build_list(void *items, size_t count, size_t stride, int (*cmp)(const void *, const void *)) {
+    List *list = init_list(cmp, NULL);
+    for (size_t i = 0; i < count; i++) {
+        insert_at_tail(list, (char *)items + i * stride);
+    }
+    return list;
+}
+
+static bool is_sorted(List *list) {
+    for (ListNode *node = list->head; node && node->next; node = node->next) {
+        if (list->cmp(node->data, node->next->data) > 0) return false;
+    }
+    return true;
+}
+
+// 分别用归并排序与基数排序处理同一组数据，输出耗时
+static void run_case(const char *name, void *items, size_t count, size_t stride,
+                     int (*cmp)(const void *, const void *),
+                     key_fn key, bytes_key_fn bytes_key) {
+    struct timespec start;
+
+    List *list = build_list(items, count, stride, cmp);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    sort_list(list);
+    double merge_seconds = elapsed_since(start);
+    bool merge_ok = is_sorted(list);
+    destroy_list(list);
+
+    list = build_list(items, count, stride, cmp);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (key) {
+        sort_list_by_key(list, key);
+    } else {
+        sort_list_by_bytes(list, bytes_key);
+    }
+    double radix_seconds = elapsed_since(start);
+    bool radix_ok = is_sorted(list);
+    destroy_list(list);
+
+    printf("%-22s 归并 %8.3f秒%s  基数 %8.3f秒%s  加速比 %.2fx\n", name,
+           merge_seconds, merge_ok ? "" : "(错误)", radix_seconds, radix_ok ? "" : "(错误)",
+           merge_seconds / radix_seconds);
+}
+
+static void run_size(size_t count) {
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+    printf("\n%zu 个元素\n", count);
+
+    uint64_t *ids = malloc(count * sizeof(uint64_t));
+    for (size_t i = 0; i < count; i++) {
+        ids[i] = next_random(&state);
+    }
+    run_case("随机 64 位 ID", ids, count, sizeof(uint64_t), u64_cmp, u64_key, NULL);
+
+    // 时间戳：基本有序，约 1% 的元素乱序
+    uint64_t base = 1700000000000ULL;
+    for (size_t i = 0; i < count; i++) {
+        ids[i] = base + i * 10;
+    }
+    for (size_t i = 0; i < count / 100; i++) {
+        size_t a = next_random(&state) % count;
+        size_t b = next_random(&state) % count;
+        uint64_t swap = ids[a];
+        ids[a] = ids[b];
+        ids[b] = swap;
+    }
+    run_case("基本有序的时间戳", ids, count, sizeof(uint64_t), u64_cmp, u64_key, NULL);
+    free(ids);
+
+    char *strs = malloc(count * STR_KEY_BYTES);
+    for (size_t i = 0; i < count; i++) {
+        char *s = strs + i * STR_KEY_BYTES;
+        int length = 8 + next_random(&state) % (STR_KEY_BYTES - 8);
+        for (int j = 0; j < length; j++) {
+            s[j] = 'a' + next_random(&state) % 26;
+        }
+        s[length] = '\0';
+    }
+    run_case("随机字符串", strs, count, STR_KEY_BYTES, str_cmp, NULL, str_key);
+    free(strs);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 1) {
+        for (int i = 1; i < argc; i++) {
+            size_t count = strtoul(argv[i], NULL, 10);
+            if (count > 0) run_size(count);
+        }
+    } else {
+        run_size(1000000);
+        run_size(10000000);
+    }
+    return 0;
+}
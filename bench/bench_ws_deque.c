@@ -0,0 +1,145 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <time.h>
+#include "ws_deque.h"
+
+// 基准：递归拆分的任务树（每个任务派生两个子任务直到指定深度）
+// 对比工作窃取线程池与互斥锁保护的共享 List 任务队列
+// 用法: ./bench_ws_deque [线程数] [深度]
+
+static atomic_size_t leaves = 0;
+
+static double elapsed_since(struct timespec start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+// 叶子任务做少量计算，模拟真实任务
+static void leaf_work(void) {
+    volatile unsigned int x = 0;
+    for (int i = 0; i < 200; i++) {
+        x += i;
+    }
+    atomic_fetch_add_explicit(&leaves, 1, memory_order_relaxed);
+}
+
+// ==================== 工作窃取线程池 ====================
+
+typedef struct {
+    WorkerPool *pool;
+    int depth;
+} PoolNode;
+
+static PoolNode pool_nodes[64];
+
+static void pool_task(void *arg) {
+    PoolNode *node = arg;
+    if (node->depth == 0) {
+        leaf_work();
+        return;
+    }
+    worker_pool_submit(node->pool, pool_task, &pool_nodes[node->depth - 1]);
+    worker_pool_submit(node->pool, pool_task, &pool_nodes[node->depth - 1]);
+}
+
+static double run_pool(int threads, int depth) {
+    WorkerPool *pool = worker_pool_create(threads);
+    for (int i = 0; i <= depth; i++) {
+        pool_nodes[i].pool = pool;
+        pool_nodes[i].depth = i;
+    }
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    worker_pool_submit(pool, pool_task, &pool_nodes[depth]);
+    worker_pool_wait(pool);
+    double seconds = elapsed_since(start);
+
+    worker_pool_destroy(pool);
+    return seconds;
+}
+
+// ==================== 互斥锁 + 共享 List ====================
+
+typedef struct {
+    pthread_mutex_t lock;
+    List *queue;
+    atomic_size_t pending;
+} SharedQueue;
+
+static void *shared_worker(void *arg) {
+    SharedQueue *shared = arg;
+    while (atomic_load(&shared->pending) > 0) {
+        pthread_mutex_lock(&shared->lock);
+        int *depth = shared->queue->head ? shared->queue->head->data : NULL;
+        if (depth) delete_at_head(shared->queue);
+        pthread_mutex_unlock(&shared->lock);
+
+        if (!depth) {
+            sched_yield();
+            continue;
+        }
+
+        if (*depth == 0) {
+            leaf_work();
+        } else {
+            atomic_fetch_add(&shared->pending, 2);
+            pthread_mutex_lock(&shared->lock);
+            insert_at_tail(shared->queue, &pool_nodes[*depth - 1].depth);
+            insert_at_tail(shared->queue, &pool_nodes[*depth - 1].depth);
+            pthread_mutex_unlock(&shared->lock);
+        }
+        atomic_fetch_sub(&shared->pending, 1);
+    }
+    return NULL;
+}
+
+static double run_shared(int threads, int depth) {
+    SharedQueue shared;
+    pthread_mutex_init(&shared.lock, NULL);
+    shared.queue = init_list(NULL, NULL);
+    atomic_init(&shared.pending, 1);
+    for (int i = 0; i <= depth; i++) {
+        pool_nodes[i].depth = i;
+    }
+    insert_at_tail(shared.queue, &pool_nodes[depth].depth);
+
+    pthread_t *workers = malloc(threads * sizeof(pthread_t));
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < threads; i++) {
+        pthread_create(&workers[i], NULL, shared_worker, &shared);
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    double seconds = elapsed_since(start);
+
+    free(workers);
+    destroy_list(shared.queue);
+    pthread_mutex_destroy(&shared.lock);
+    return seconds;
+}
+
+int main(int argc, char *argv[]) {
+    int threads = argc > 1 ? atoi(argv[1]) : 4;
+    int depth = argc > 2 ? atoi(argv[2]) : 18;
+    if (threads < 1) threads = 1;
+    if (depth < 1 || depth > 40) depth = 18;
+
+    size_t expected = (size_t)1 << depth;
+    printf("任务树深度 %d（%zu 个叶子任务），%d 个工作线程\n", depth, expected, threads);
+
+    atomic_store(&leaves, 0);
+    double shared_seconds = run_shared(threads, depth);
+    printf("互斥锁 + 共享 List: %.4f秒 (%zu 个叶子)\n", shared_seconds, atomic_load(&leaves));
+
+    atomic_store(&leaves, 0);
+    double pool_seconds = run_pool(threads, depth);
+    printf("工作窃取线程池:     %.4f秒 (%zu 个叶子)\n", pool_seconds, atomic_load(&leaves));
+
+    printf("加速比: %.2fx\n", shared_seconds / pool_seconds);
+    return 0;
+}
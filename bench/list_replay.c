@@ -0,0 +1,33 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "list_trace.h"
+
+// 回放工具：把 -DLIST_TRACE 构建采集到的跟踪文件交给链表后端重新执行，输出吞吐量与延迟
+// 用法: ./list_replay <跟踪文件> [重复次数]
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "用法: %s <跟踪文件> [重复次数]\n", argv[0]);
+        return 1;
+    }
+
+    int rounds = argc > 2 ? atoi(argv[2]) : 1;
+    if (rounds < 1) rounds = 1;
+
+    const TraceBackend *backends[] = {&list_trace_list_backend};
+    size_t backend_count = sizeof(backends) / sizeof(backends[0]);
+
+    for (size_t i = 0; i < backend_count; i++) {
+        for (int round = 0; round < rounds; round++) {
+            TraceReplayStats stats;
+            if (!list_trace_replay(argv[1], backends[i], &stats)) {
+                fprintf(stderr, "Error: 无法回放跟踪文件 %s\n", argv[1]);
+                return 1;
+            }
+            printf("\n=== 第 %d 轮 ===\n", round + 1);
+            list_trace_print_stats(stdout, backends[i]->name, &stats);
+        }
+    }
+
+    return 0;
+}
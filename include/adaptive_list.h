@@ -0,0 +1,106 @@
+#ifndef __ADAPTIVE_LIST_H
+#define __ADAPTIVE_LIST_H
+
+#include "list.h"
+
+// 自适应链表：接口与 list.h 的按位置 / 按值操作一致，内部表示随观察到的操作分布切换：
+//   ADAPTIVE_LINKED   双向链表（list.h），游标处插入 / 删除 O(1)，适合边遍历边修改
+//   ADAPTIVE_RING     连续的环形缓冲区，头尾进出不分配内存、按位置读取 O(1)、查找连续扫描，适合队列与读多写少
+//   ADAPTIVE_CHUNKED  分块数组（每块最多 ADAPTIVE_CHUNK 个元素），按位置插入 / 删除只移动一块，适合按位置编辑
+// 每次操作按三种表示各自的估算代价累加，每 ADAPTIVE_WINDOW 次操作比较一次：
+// 另一种表示比当前表示便宜超过 ADAPTIVE_MARGIN 的窗口连续出现至少 ADAPTIVE_CONFIRM 个，
+// 且这些窗口累计省下的代价超过迁移本身（O(n) 搬移元素指针）时才迁移，避免在两种表示间来回切换。
+// 没有节点：查找、按位置访问返回数据指针；迁移不移动数据本身，数据指针始终有效
+
+#define ADAPTIVE_CHUNK 64
+#define ADAPTIVE_WINDOW 256
+#define ADAPTIVE_CONFIRM 2
+#define ADAPTIVE_MARGIN 0.25
+
+typedef enum {
+    ADAPTIVE_LINKED,
+    ADAPTIVE_RING,
+    ADAPTIVE_CHUNKED,
+    ADAPTIVE_REPR_COUNT
+} AdaptiveRepr;
+
+typedef struct {
+    size_t count;
+    void *items[ADAPTIVE_CHUNK];
+} AdaptiveChunk;
+
+typedef struct {
+    AdaptiveRepr repr;
+    size_t size;            // 元素个数
+    size_t version;         // 每次修改递增，游标据此判断缓存的位置是否失效
+
+    // ADAPTIVE_LINKED：链表不持有数据，迁移时只释放节点
+    List linked;
+
+    // ADAPTIVE_RING：第 i 个元素位于 ring[(ring_head + i) & (ring_capacity - 1)]
+    void **ring;
+    size_t ring_head;
+    size_t ring_capacity;   // 2 的幂
+
+    // ADAPTIVE_CHUNKED：块指针数组，每块至少有一个元素
+    AdaptiveChunk **chunks;
+    size_t chunk_count;
+    size_t chunk_slots;     // chunks 数组的容量
+
+    // 采样
+    bool adaptive;          // 为 false 时固定在当前表示
+    double cost[ADAPTIVE_REPR_COUNT]; // 本窗口内各表示的估算代价
+    size_t window_ops;      // 本窗口已记录的操作数
+    AdaptiveRepr candidate; // 上一窗口最便宜的表示
+    size_t streak;          // candidate 连续最便宜的窗口数
+    double savings;         // 这些窗口里 candidate 累计省下的代价
+    size_t migrations;      // 累计迁移次数
+
+    // 函数指针
+    int (*cmp)(const void *a, const void *b);
+    void (*free_data)(void *data);
+} AdaptiveList;
+
+// 游标：指向某个元素（或末尾），经游标插入 / 删除后仍有效；
+// 绕过游标修改链表或发生迁移后，下次使用时按位置重新定位
+typedef struct {
+    AdaptiveList *list;
+    size_t position;
+    size_t version;
+    ListNode *node;         // ADAPTIVE_LINKED 下的当前节点
+    size_t chunk;           // ADAPTIVE_CHUNKED 下的当前块与块内下标
+    size_t offset;
+} AdaptiveCursor;
+
+AdaptiveList* adaptive_list_create(int (*cmp)(const void *, const void *), void (*free_data)(void *));
+void adaptive_list_destroy(AdaptiveList* list);
+
+// 与 list.h 同名操作语义相同（删除时调用 free_data 释放数据）
+bool adaptive_insert_at_head(AdaptiveList* list, void* data);
+bool adaptive_insert_at_tail(AdaptiveList* list, void* data);
+bool adaptive_insert_at_position(AdaptiveList* list, void* data, int position);
+bool adaptive_delete_at_head(AdaptiveList* list);
+bool adaptive_delete_at_tail(AdaptiveList* list);
+bool adaptive_delete_at_position(AdaptiveList* list, int position);
+bool adaptive_delete_by_value(AdaptiveList* list, void* key);
+bool adaptive_update_by_value(AdaptiveList* list, const void* key, const void* new_value, update_fn updater);
+void* adaptive_search_by_value(AdaptiveList* list, void* key);     // 返回第一个匹配的数据
+void* adaptive_get_at_position(AdaptiveList* list, int position);
+size_t adaptive_get_length(AdaptiveList* list);
+bool adaptive_is_empty(AdaptiveList* list);
+void adaptive_for_each(AdaptiveList* list, void (*fn)(void *data, void *ctx), void* ctx);
+void adaptive_clear(AdaptiveList* list);
+
+// 游标
+AdaptiveCursor adaptive_cursor(AdaptiveList* list);                // 指向第一个元素
+void* adaptive_cursor_get(AdaptiveCursor* cursor);                 // 当前元素，到末尾返回 NULL
+bool adaptive_cursor_next(AdaptiveCursor* cursor);
+bool adaptive_cursor_insert(AdaptiveCursor* cursor, void* data);   // 插入到当前元素之前，游标仍指向当前元素
+bool adaptive_cursor_remove(AdaptiveCursor* cursor);               // 删除当前元素，游标指向下一个
+
+// 表示控制
+AdaptiveRepr adaptive_list_repr(AdaptiveList* list);
+bool adaptive_list_convert(AdaptiveList* list, AdaptiveRepr repr);    // 立即迁移到指定表示
+void adaptive_list_set_adaptive(AdaptiveList* list, bool adaptive);   // 关闭后固定在当前表示
+
+#endif
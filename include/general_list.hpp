@@ -0,0 +1,671 @@
+#ifndef __GENERAL_LIST_HPP
+#define __GENERAL_LIST_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// C++ 版双向链表：节点逻辑与 list.h 相同（link / unlink 维护 size），但首尾经链表内的哨兵节点连成环，
+// end() 就是哨兵，--end() 取哨兵的 prev，不依赖迭代器来自哪个链表。
+// 元素 T 直接存放在节点内，一个元素只分配一次，没有 void* 数据、free_data 回调和间接比较。
+// 节点经分配器分配（rebind 到节点类型），支持 std::pmr；只要求 T 可移动构造或原地构造。
+// 迭代器为双向迭代器，可用于 <algorithm>；插入、摘链、splice、swap、移动都不使指向元素的迭代器失效
+// （元素的迭代器随节点转到新链表），end() 属于链表对象本身，不随元素转移。
+// splice 与挂回摘下的节点要求两边分配器相等
+
+namespace general {
+
+template <class T, class Alloc = std::allocator<T>>
+class list;
+
+namespace detail {
+
+struct node_base {
+    node_base *prev;
+    node_base *next;
+};
+
+template <class T>
+struct node : node_base {
+    // 由 list 经分配器原地构造 / 析构，节点本身不构造 value
+    union {
+        T value;
+    };
+
+    node() {}
+    ~node() {}
+};
+
+template <class T, bool Const>
+class list_iterator {
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+
+    list_iterator() = default;
+
+    // iterator 可隐式转换为 const_iterator
+    template <bool C = Const, std::enable_if_t<C, int> = 0>
+    list_iterator(const list_iterator<T, false> &other) : node_(other.node_) {}
+
+    reference operator*() const { return static_cast<node<T> *>(node_)->value; }
+    pointer operator->() const { return std::addressof(**this); }
+
+    list_iterator &operator++() {
+        node_ = node_->next;
+        return *this;
+    }
+
+    list_iterator operator++(int) {
+        list_iterator old = *this;
+        ++*this;
+        return old;
+    }
+
+    list_iterator &operator--() {
+        node_ = node_->prev;
+        return *this;
+    }
+
+    list_iterator operator--(int) {
+        list_iterator old = *this;
+        --*this;
+        return old;
+    }
+
+    friend bool operator==(const list_iterator &a, const list_iterator &b) { return a.node_ == b.node_; }
+    friend bool operator!=(const list_iterator &a, const list_iterator &b) { return a.node_ != b.node_; }
+
+private:
+    template <class, class> friend class general::list;
+    template <class, bool> friend class list_iterator;
+
+    explicit list_iterator(node_base *node) : node_(node) {}
+
+    node_base *node_ = nullptr;
+};
+
+} // namespace detail
+
+template <class T, class Alloc>
+class list {
+    using node = detail::node<T>;
+    using node_base = detail::node_base;
+    using alloc_traits = std::allocator_traits<Alloc>;
+    using node_alloc_type = typename alloc_traits::template rebind_alloc<node>;
+    using node_traits = std::allocator_traits<node_alloc_type>;
+
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = typename alloc_traits::pointer;
+    using const_pointer = typename alloc_traits::const_pointer;
+    using iterator = detail::list_iterator<T, false>;
+    using const_iterator = detail::list_iterator<T, true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // 摘下的节点：独占一个已构造的元素，可挂回分配器相等的链表；析构时释放
+    class node_type {
+    public:
+        node_type() = default;
+        node_type(node_type &&other) noexcept : alloc_(std::move(other.alloc_)), node_(other.node_) {
+            other.alloc_.reset();
+            other.node_ = nullptr;
+        }
+        node_type &operator=(node_type &&other) noexcept {
+            if (this != &other) {
+                reset();
+                alloc_ = std::move(other.alloc_);
+                node_ = other.node_;
+                other.alloc_.reset();
+                other.node_ = nullptr;
+            }
+            return *this;
+        }
+        ~node_type() { reset(); }
+
+        bool empty() const noexcept { return node_ == nullptr; }
+        explicit operator bool() const noexcept { return node_ != nullptr; }
+        T &value() const { return node_->value; }
+        allocator_type get_allocator() const { return allocator_type(*alloc_); }
+
+    private:
+        friend class list;
+
+        node_type(const node_alloc_type &alloc, node *n) : alloc_(alloc), node_(n) {}
+
+        void reset() {
+            if (node_) destroy_node(*alloc_, node_);
+            alloc_.reset();
+            node_ = nullptr;
+        }
+
+        std::optional<node_alloc_type> alloc_;
+        node *node_ = nullptr;
+    };
+
+    // ==================== 构造 / 析构 ====================
+
+    list() : list(Alloc()) {}
+    explicit list(const Alloc &alloc) : alloc_(alloc) {}
+
+    list(std::initializer_list<T> values, const Alloc &alloc = Alloc()) : list(values.begin(), values.end(), alloc) {}
+
+    template <class InputIt, class = typename std::iterator_traits<InputIt>::iterator_category>
+    list(InputIt first, InputIt last, const Alloc &alloc = Alloc()) : alloc_(alloc) {
+        guard g{this};
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+        g.release();
+    }
+
+    list(const list &other)
+        : list(other, alloc_traits::select_on_container_copy_construction(other.get_allocator())) {}
+
+    list(const list &other, const Alloc &alloc) : alloc_(alloc) {
+        guard g{this};
+        for (const T &value : other) {
+            emplace_back(value);
+        }
+        g.release();
+    }
+
+    list(list &&other) noexcept : alloc_(std::move(other.alloc_)) {
+        steal(other);
+    }
+
+    // 分配器不等时只能逐个移动元素
+    list(list &&other, const Alloc &alloc) : alloc_(alloc) {
+        if (get_allocator() == other.get_allocator()) {
+            steal(other);
+            return;
+        }
+        guard g{this};
+        for (T &value : other) {
+            emplace_back(std::move(value));
+        }
+        g.release();
+    }
+
+    ~list() { clear(); }
+
+    list &operator=(const list &other) {
+        if (this == &other) return *this;
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+            if (alloc_ != other.alloc_) clear();
+            alloc_ = other.alloc_;
+        }
+        assign(other.begin(), other.end());
+        return *this;
+    }
+
+    list &operator=(list &&other) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                           alloc_traits::is_always_equal::value) {
+        if (this == &other) return *this;
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+            clear();
+            alloc_ = std::move(other.alloc_);
+            steal(other);
+        } else if (alloc_ == other.alloc_) {
+            clear();
+            steal(other);
+        } else {
+            assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        }
+        return *this;
+    }
+
+    list &operator=(std::initializer_list<T> values) {
+        assign(values.begin(), values.end());
+        return *this;
+    }
+
+    // 复用已有节点赋值，多出的删除，不足的追加
+    template <class InputIt>
+    void assign(InputIt first, InputIt last) {
+        iterator it = begin();
+        for (; it != end() && first != last; ++it, ++first) {
+            *it = *first;
+        }
+        if (first == last) {
+            erase(it, end());
+        } else {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+    }
+
+    void swap(list &other) noexcept {
+        if constexpr (alloc_traits::propagate_on_container_swap::value) {
+            std::swap(alloc_, other.alloc_);
+        } else {
+            assert(alloc_ == other.alloc_);
+        }
+        // 节点首尾指向各自的哨兵，交换时重新挂到对方的哨兵上
+        node_base *first = sentinel_.next;
+        node_base *last = sentinel_.prev;
+        size_type count = size_;
+        steal(other);
+        if (count) other.link_run(&other.sentinel_, first, last, count);
+    }
+
+    friend void swap(list &a, list &b) noexcept { a.swap(b); }
+
+    allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+    // ==================== 访问 ====================
+
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+
+    T &front() { return value_of(sentinel_.next); }
+    const T &front() const { return value_of(sentinel_.next); }
+    T &back() { return value_of(sentinel_.prev); }
+    const T &back() const { return value_of(sentinel_.prev); }
+
+    iterator begin() noexcept { return iterator(sentinel_.next); }
+    iterator end() noexcept { return iterator(&sentinel_); }
+    const_iterator begin() const noexcept { return const_iterator(sentinel_.next); }
+    const_iterator end() const noexcept { return const_iterator(const_cast<node_base *>(&sentinel_)); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // ==================== 插入 ====================
+    // 元素在节点内原地构造；构造抛出异常时节点被释放，链表不变
+
+    template <class... Args>
+    iterator emplace(const_iterator pos, Args &&...args) {
+        node *n = create_node(std::forward<Args>(args)...);
+        link_node(pos.node_->prev, n, pos.node_);
+        return make_iterator(n);
+    }
+
+    template <class... Args>
+    T &emplace_front(Args &&...args) {
+        return *emplace(cbegin(), std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    T &emplace_back(Args &&...args) {
+        return *emplace(cend(), std::forward<Args>(args)...);
+    }
+
+    // 在第 position 个元素之前构造（position == size() 时追加），与 insert_at_position 相同，从较近的一端数
+    template <class... Args>
+    iterator emplace_at(size_type position, Args &&...args) {
+        if (position > size_) throw std::out_of_range("general::list::emplace_at");
+        return emplace(at_position(position), std::forward<Args>(args)...);
+    }
+
+    iterator insert(const_iterator pos, const T &value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T &&value) { return emplace(pos, std::move(value)); }
+    void push_front(const T &value) { emplace_front(value); }
+    void push_front(T &&value) { emplace_front(std::move(value)); }
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    // ==================== 删除 ====================
+
+    iterator erase(const_iterator pos) {
+        node_base *next = pos.node_->next;
+        unlink_node(pos.node_);
+        destroy_node(alloc_, static_cast<node *>(pos.node_));
+        return make_iterator(next);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        while (first != last) {
+            first = erase(first);
+        }
+        return make_iterator(last.node_);
+    }
+
+    void pop_front() { erase(cbegin()); }
+    void pop_back() { erase(const_iterator(sentinel_.prev)); }
+
+    void clear() noexcept {
+        node_base *current = sentinel_.next;
+        while (current != &sentinel_) {
+            node_base *next = current->next;
+            destroy_node(alloc_, static_cast<node *>(current));
+            current = next;
+        }
+        reset();
+    }
+
+    // 匹配的节点先摘下串成一条 next 链，扫描结束后再销毁：
+    // pred 或 remove 的 value 引用链表内的元素时（如 l.remove(l.front())），扫描中不会访问已销毁的元素
+    template <class Pred>
+    size_type remove_if(Pred pred) {
+        struct doomed_chain {
+            node_alloc_type &alloc;
+            node_base *first = nullptr;
+            ~doomed_chain() {
+                while (first) {
+                    node_base *next = first->next;
+                    destroy_node(alloc, static_cast<node *>(first));
+                    first = next;
+                }
+            }
+        } doomed{alloc_};
+
+        size_type removed = 0;
+        for (node_base *n = sentinel_.next; n != &sentinel_;) {
+            node_base *next = n->next;
+            if (pred(value_of(n))) {
+                unlink_node(n);
+                n->next = doomed.first;
+                doomed.first = n;
+                removed++;
+            }
+            n = next;
+        }
+        return removed;
+    }
+
+    size_type remove(const T &value) {
+        return remove_if([&value](const T &item) { return item == value; });
+    }
+
+    // ==================== 查找 ====================
+
+    iterator find(const T &value) {
+        for (node_base *n = sentinel_.next; n != &sentinel_; n = n->next) {
+            if (value_of(n) == value) return make_iterator(n);
+        }
+        return end();
+    }
+
+    const_iterator find(const T &value) const {
+        return const_cast<list *>(this)->find(value);
+    }
+
+    // ==================== 摘链 / 挂链 ====================
+    // 只改链接，不分配、不复制、不移动元素
+
+    // 摘下节点，元素所有权转给返回的句柄
+    node_type extract(const_iterator pos) {
+        unlink_node(pos.node_);
+        return node_type(alloc_, static_cast<node *>(pos.node_));
+    }
+
+    // 把摘下的节点挂到 pos 之前，句柄变空
+    iterator insert(const_iterator pos, node_type &&nh) {
+        if (nh.empty()) return make_iterator(pos.node_);
+        assert(*nh.alloc_ == alloc_);
+        node *n = nh.node_;
+        nh.node_ = nullptr;
+        nh.alloc_.reset();
+        link_node(pos.node_->prev, n, pos.node_);
+        return make_iterator(n);
+    }
+
+    // 把 other 的全部节点移到 pos 之前，O(1)
+    void splice(const_iterator pos, list &other) {
+        if (this == &other || other.empty()) return;
+        node_base *first = other.sentinel_.next;
+        node_base *last = other.sentinel_.prev;
+        size_type count = other.size_;
+        other.unlink_run(first, last, count);
+        splice_run(pos, first, last, count, other);
+    }
+
+    void splice(const_iterator pos, list &&other) { splice(pos, other); }
+
+    // 把 other 中 it 指向的节点移到 pos 之前
+    void splice(const_iterator pos, list &other, const_iterator it) {
+        if (pos == it || pos.node_ == it.node_->next) return;
+        other.unlink_node(it.node_);
+        splice_run(pos, it.node_, it.node_, 1, other);
+    }
+
+    void splice(const_iterator pos, list &&other, const_iterator it) { splice(pos, other, it); }
+
+    // 把 other 的 [first, last) 移到 pos 之前；跨链表时数出段长 O(段长)
+    void splice(const_iterator pos, list &other, const_iterator first, const_iterator last) {
+        if (first == last) return;
+        node_base *run_first = first.node_;
+        node_base *run_last = last.node_->prev;
+        size_type count = 0;
+        if (this != &other) {
+            for (node_base *n = run_first; n != last.node_; n = n->next) {
+                count++;
+            }
+        }
+        other.unlink_run(run_first, run_last, count);
+        splice_run(pos, run_first, run_last, count, other);
+    }
+
+    void splice(const_iterator pos, list &&other, const_iterator first, const_iterator last) {
+        splice(pos, other, first, last);
+    }
+
+    // ==================== 重排 ====================
+
+    // 每个节点（含哨兵）交换 prev / next
+    void reverse() noexcept {
+        node_base *n = &sentinel_;
+        do {
+            std::swap(n->prev, n->next);
+            n = n->prev;
+        } while (n != &sentinel_);
+    }
+
+    // 稳定排序，只重新链接节点，与 sort_list 相同的自底向上归并
+    template <class Compare = std::less<>>
+    void sort(Compare comp = Compare()) {
+        if (size_ < 2) return;
+
+        // runs[k] 保存长度为 2^k 的有序段，新节点像二进制进位一样逐级合并
+        node_base *runs[64] = {nullptr};
+        sentinel_.prev->next = nullptr;
+        node_base *n = sentinel_.next;
+        while (n) {
+            node_base *next = n->next;
+            n->next = nullptr;
+
+            node_base *carry = n;
+            int k = 0;
+            for (; runs[k]; k++) {
+                carry = merge_chains(runs[k], carry, comp);
+                runs[k] = nullptr;
+            }
+            runs[k] = carry;
+            n = next;
+        }
+
+        // 高位的段包含更早的元素，作为左侧参与合并
+        node_base *first = nullptr;
+        for (int k = 0; k < 64; k++) {
+            if (runs[k]) first = merge_chains(runs[k], first, comp);
+        }
+        relink_chain(first);
+    }
+
+    friend bool operator==(const list &a, const list &b) {
+        if (a.size_ != b.size_) return false;
+        node_base *x = a.sentinel_.next;
+        node_base *y = b.sentinel_.next;
+        for (; x != &a.sentinel_; x = x->next, y = y->next) {
+            if (!(value_of(x) == value_of(y))) return false;
+        }
+        return true;
+    }
+
+    friend bool operator!=(const list &a, const list &b) { return !(a == b); }
+
+private:
+    // 构造中途抛出异常时释放已插入的元素
+    struct guard {
+        list *owner;
+        void release() { owner = nullptr; }
+        ~guard() {
+            if (owner) owner->clear();
+        }
+    };
+
+    static T &value_of(node_base *n) { return static_cast<node *>(n)->value; }
+
+    iterator make_iterator(node_base *n) { return iterator(n); }
+
+    template <class... Args>
+    node *create_node(Args &&...args) {
+        node *n = node_traits::allocate(alloc_, 1);
+        ::new (static_cast<void *>(n)) node();
+        try {
+            // 经元素分配器构造，pmr 下元素内部的容器也使用同一内存资源
+            Alloc value_alloc(alloc_);
+            alloc_traits::construct(value_alloc, std::addressof(n->value), std::forward<Args>(args)...);
+        } catch (...) {
+            n->~node();
+            node_traits::deallocate(alloc_, n, 1);
+            throw;
+        }
+        return n;
+    }
+
+    static void destroy_node(node_alloc_type &alloc, node *n) {
+        Alloc value_alloc(alloc);
+        alloc_traits::destroy(value_alloc, std::addressof(n->value));
+        n->~node();
+        node_traits::deallocate(alloc, n, 1);
+    }
+
+    // 把 node 链接到 prev 与 next 之间（头尾处为哨兵）
+    void link_node(node_base *prev, node_base *n, node_base *next) noexcept {
+        n->prev = prev;
+        n->next = next;
+        prev->next = n;
+        next->prev = n;
+        size_++;
+    }
+
+    void unlink_node(node_base *n) noexcept {
+        unlink_run(n, n, 1);
+    }
+
+    // 摘下 [first, last] 这一段（共 count 个节点），段内链接不变
+    void unlink_run(node_base *first, node_base *last, size_type count) noexcept {
+        first->prev->next = last->next;
+        last->next->prev = first->prev;
+        size_ -= count;
+    }
+
+    // 把 [first, last] 整段链接到 pos 之前
+    void link_run(node_base *pos, node_base *first, node_base *last, size_type count) noexcept {
+        node_base *prev = pos->prev;
+        first->prev = prev;
+        last->next = pos;
+        prev->next = first;
+        pos->prev = last;
+        size_ += count;
+    }
+
+    void splice_run(const_iterator pos, node_base *first, node_base *last, size_type count, list &other) {
+        assert(alloc_ == other.alloc_);
+        (void)other;
+        link_run(pos.node_, first, last, count);
+    }
+
+    // 从较近的一端数到第 position 个节点，position == size_ 时为 end()
+    const_iterator at_position(size_type position) const {
+        node_base *n = const_cast<node_base *>(&sentinel_);
+        if (position <= size_ / 2) {
+            n = n->next;
+            for (size_type i = 0; i < position; i++) {
+                n = n->next;
+            }
+        } else {
+            for (size_type i = size_; i > position; i--) {
+                n = n->prev;
+            }
+        }
+        return const_iterator(n);
+    }
+
+    void reset() noexcept {
+        sentinel_.prev = sentinel_.next = &sentinel_;
+        size_ = 0;
+    }
+
+    // 接管 other 的全部节点（本链表的节点不再引用），other 变空
+    void steal(list &other) noexcept {
+        reset();
+        if (other.empty()) return;
+        node_base *first = other.sentinel_.next;
+        node_base *last = other.sentinel_.prev;
+        size_type count = other.size_;
+        other.reset();
+        link_run(&sentinel_, first, last, count);
+    }
+
+    // 合并两条以空指针结尾的有序 next 链，相等时 a 在前（保持稳定）
+    template <class Compare>
+    static node_base *merge_chains(node_base *a, node_base *b, Compare &comp) {
+        node_base *first = nullptr;
+        node_base **out = &first;
+        while (a && b) {
+            if (!comp(value_of(b), value_of(a))) {
+                *out = a;
+                a = a->next;
+            } else {
+                *out = b;
+                b = b->next;
+            }
+            out = &(*out)->next;
+        }
+        *out = a ? a : b;
+        return first;
+    }
+
+    // 按 next 链重建 prev，并把首尾接回哨兵
+    void relink_chain(node_base *first) noexcept {
+        node_base *prev = &sentinel_;
+        for (node_base *n = first; n; n = n->next) {
+            n->prev = prev;
+            prev = n;
+        }
+        sentinel_.next = first ? first : &sentinel_;
+        prev->next = &sentinel_;
+        sentinel_.prev = prev;
+    }
+
+    node_alloc_type alloc_;
+    node_base sentinel_{&sentinel_, &sentinel_};    // next 为首节点，prev 为尾节点，空表时指向自身
+    size_type size_ = 0;
+};
+
+namespace pmr {
+
+template <class T>
+using list = general::list<T, std::pmr::polymorphic_allocator<T>>;
+
+} // namespace pmr
+
+} // namespace general
+
+#endif
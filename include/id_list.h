@@ -0,0 +1,54 @@
+#ifndef __ID_LIST_H
+#define __ID_LIST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// 压缩 ID 链表：严格递增的 64 位 ID 按 ID_BLOCK_COUNT 个一块存储，
+// 块内只保存第一个 ID 和相邻差值，差值按块内最大差值所需的位数紧密排列（delta + bit-packing）。
+// 块头数组同时是跳跃索引：按块的首尾 ID 二分定位，只解码一个块。
+// 连续或间隔较小的 ID 每个只占 1~2 字节（List 中每个 ID 约 50 字节：节点 + 单独分配的数据）
+
+#define ID_BLOCK_COUNT 128
+
+typedef struct {
+    int64_t first;          // 块内第一个 ID
+    int64_t last;           // 块内最后一个 ID
+    uint64_t *bits;         // count - 1 个差值，每个 width 位，低位在前
+    uint32_t count;         // 块内 ID 数，至少为 1
+    uint16_t words;         // bits 的容量（64 位字数）
+    uint8_t width;          // 差值的位数，只有一个 ID 时为 0
+} IdBlock;
+
+typedef struct {
+    IdBlock *blocks;        // 按 ID 递增排列的块头（跳跃索引）
+    size_t block_count;
+    size_t block_slots;     // blocks 数组的容量
+    size_t size;            // ID 总数
+} IdList;
+
+// 顺序遍历：每次解码一整块到缓冲区
+typedef struct {
+    IdList *list;
+    size_t block;           // 下一个要解码的块
+    size_t index;           // 缓冲区中的下一个位置
+    size_t count;           // 缓冲区中的 ID 数
+    int64_t buffer[ID_BLOCK_COUNT];
+} IdIterator;
+
+IdList* id_list_create(void);
+void id_list_destroy(IdList* list);
+
+bool id_list_append(IdList* list, int64_t id);      // id 须大于当前最大的 ID
+bool id_list_contains(IdList* list, int64_t id);
+bool id_list_delete(IdList* list, int64_t id);      // 重写所在块，块删空时移除，过小时与后一块合并
+
+size_t id_list_size(IdList* list);
+size_t id_list_memory(IdList* list);                // 占用的字节数（不含分配器自身的开销）
+
+IdIterator id_list_begin(IdList* list);
+bool id_list_next(IdIterator* it, int64_t* id);     // 到末尾返回 false
+size_t id_list_for_each(IdList* list, void (*fn)(int64_t id, void *ctx), void* ctx); // 返回访问的 ID 数
+
+#endif
@@ -3,33 +3,87 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 typedef void (*update_fn)(void *data, const void *new_value);
 typedef bool (*predicate_fn)(const void *data);
+typedef uint64_t (*hash_fn)(const void *data);
+typedef void* (*copy_fn)(const void *data);
+typedef uint64_t (*key_fn)(const void *data);                       // 整数排序键（按无符号比较）
+typedef const void* (*bytes_key_fn)(const void *data, size_t *length); // 字节串排序键（按字节字典序比较）
+// 批量比较：data 为逻辑上连续的 count 个（不超过 LIST_BATCH_SIZE）节点的数据，
+// 返回掩码，第 i 位为 1 表示 data[i] 与 key 相等；便于调用者一次比较多个元素并向量化
+typedef uint64_t (*batch_cmp_fn)(const void *key, const void *const *data, size_t count);
+#define LIST_BATCH_SIZE 16
+
+// 把 data 序列化到 buf，返回所需字节数；所需字节数大于 capacity 时不写入
+typedef size_t (*serialize_fn)(const void *data, void *buf, size_t capacity);
+// 从 buf 反序列化出新分配的数据
+typedef void* (*deserialize_fn)(const void *buf, size_t length);
 
 typedef struct ListNode {
     void *data;             // 数据域
     struct ListNode *prev;  // 前驱指针
     struct ListNode *next;  // 后继指针
+    struct NodeBlock *block;// 所属的批量分配块，单独分配的节点为 NULL
 } ListNode;
 
+// 批量分配的节点块：块内节点全部释放后整块归还
+typedef struct NodeBlock {
+    size_t live;            // 块内尚未释放的节点数
+    size_t payload_size;    // 数据嵌入块内时每个槽位的大小（嵌入的数据随块释放，不调用 free_data），0 表示未嵌入
+    ListNode nodes[];       // 嵌入数据时节点间距大于 sizeof(ListNode)
+} NodeBlock;
+
+// 计数布隆过滤器：按值查找前排除一定不存在的键；计数器饱和后不再递减，保证无漏判
+typedef struct {
+    uint8_t *counters;      // 计数器数组，长度为 2 的幂
+    size_t mask;            // 计数器个数 - 1
+    size_t capacity;        // 元素数超过此值时扩容重建
+    size_t lookups;         // 经过过滤器的按值查找次数
+    size_t rejected;        // 被过滤器直接排除的次数
+} ListFilter;
+
 typedef struct {
     ListNode *head;     // 头指针
     ListNode *tail;     // 尾指针
     size_t size;        // 链表长度 
+    bool reversed;      // 逻辑顺序与物理链接相反：逻辑头为 tail、逻辑后继为 prev
 
     // 函数指针
     int (*cmp)(const void *a, const void *b);// 比较（查找 / 删除）
-    void (*free_data)(void *data);       // 销毁数据
+    void (*free_data)(void *data);       // 销毁数据，为 NULL 表示链表不持有数据
+    hash_fn hash;                        // 元素哈希，须与 cmp 一致（相等的元素哈希相同）
+    batch_cmp_fn batch_cmp;              // 批量比较，须与 cmp 一致；设置后按值查找 / 删除 / 更新改用它
+
+    // 顺序相关指纹，由插入 / 删除 / 更新 / 反转增量维护
+    bool fingerprint;                    // 是否维护指纹
+    uint64_t fp_forward;                 // 沿物理 next 方向的指纹
+    uint64_t fp_backward;                // 沿物理 prev 方向的指纹（reversed 时作为逻辑指纹）
+
+    ListFilter *filter;                  // 按值查找的过滤器，NULL 表示未启用
+    ListNode *compact_cursor;            // 增量压缩的下一个待搬迁节点，NULL 表示下次从头开始
+    struct ListJournal *journal;         // 预写日志，NULL 表示未启用（见 list_journal.h）
+
+    bool deferred_delete;                // 删除只标记墓碑，节点留到清理时才摘链释放
+    size_t tombstones;                   // 链表中的墓碑数（含在 size 内）
+    double purge_ratio;                  // 墓碑超过 size 的这一比例时自动清理，0 表示只手动清理
 } List;
  
-// 创建新节点
+// 创建 / 释放节点（不处理数据）
 ListNode* create_node(void* data);
+void free_node(ListNode* node);
 
 // 初始化双链表
 List* init_list(int (*cmp)(const void *, const void *), void (*free_data)(void *));
+// 初始化嵌入在其他结构中的链表
+void init_list_inplace(List* list, int (*cmp)(const void *, const void *), void (*free_data)(void *));
 
 // 是否为空
 bool is_empty(List* list);
@@ -44,6 +98,13 @@ ListNode* insert_at_position(List* list, void* data, int position);    // 在指
 ListNode* insert_after_node(List* list, ListNode* target, void* data); // 在指定节后插入
 ListNode* insert_before_node(List* list, ListNode* target, void* data);    // 在指定节点前插入
 
+// 摘链 / 挂链（不分配也不释放节点，O(1)）
+ListNode* detach_node(List* list, ListNode* node);          // 从链表中摘下节点，节点与数据保持不变
+ListNode* attach_node_at_tail(List* list, ListNode* node);  // 将游离节点挂到尾部
+ListNode* attach_node_at_head(List* list, ListNode* node);  // 将游离节点挂到头部
+bool move_to_head(List* list, ListNode* node);              // 将已在链表中的节点移到头部
+bool move_to_tail(List* list, ListNode* node);              // 将已在链表中的节点移到尾部
+
 // 删除
 bool delete_at_head(List* list);    // 头删
 bool delete_at_tail(List* list);    // 尾删
@@ -60,12 +121,23 @@ ListNode* get_node_at_position_reverse(List* list, int position);         // 从
 // 修改
 bool update_by_value(List* list, const void *key, const void *new_value, update_fn updater);
 bool update_node(List* list, ListNode* node, const void* new_value, update_fn updater);
+bool update_node_at(List* list, ListNode* node, int position, const void* new_value, update_fn updater); // 调用方已知节点的逻辑位置时免去日志数位置，-1 表示未知
+bool replace_node_data(List* list, ListNode* node, void* data);    // 用 data 替换节点数据，原数据由 free_data 释放
 size_t update_if(List* list, predicate_fn pred, const void* new_value, update_fn updater);
 
+// 逻辑方向：公共操作都按逻辑顺序工作；直接读取 head / tail / prev / next 的代码须先调用 materialize_list
+ListNode* get_first_node(List* list);                   // 逻辑头节点
+ListNode* get_last_node(List* list);                    // 逻辑尾节点
+ListNode* get_next_node(List* list, ListNode* node);    // 逻辑后继
+ListNode* get_prev_node(List* list, ListNode* node);    // 逻辑前驱
+bool materialize_list(List* list);  // 把逻辑方向落实到物理链接，O(n)；之后 head / next 即逻辑顺序
+
 // 其他操作
-bool reverse_list(List* list);  // 反转
-bool sort_list(List* list);     // 排序
-bool merge_sorted_lists(List* list1, List* list2);  // 合并两个有序列表
+bool reverse_list(List* list);  // 反转，O(1)：只翻转方向标志
+bool sort_list(List* list);     // 按 cmp 稳定归并排序
+bool sort_list_by_key(List* list, key_fn key);          // 按整数键 LSD 基数排序，稳定，O(n·8)
+bool sort_list_by_bytes(List* list, bytes_key_fn key);  // 按字节串键 MSD 基数排序，稳定
+bool merge_sorted_lists(List* list1, List* list2);  // 把有序的 list2 稳定归并进有序的 list1，list2 变为空
 bool detect_cycle();                                // 检测环
 bool remove_duplicates();                           // 去重
 bool find_middle();                                 // 找到中间节点
@@ -77,10 +149,57 @@ void clear_list(List* list);    // 清空链表
 void destroy_list(List* list);  // 销毁链表（释放所有内存）
 
 // 工具函数
-bool copy_list(List* dest_list, List* src_list);    // 复制链表
-bool compare_lists();                               // 比较两个链表
-bool concat_lists(List* list1, List* list2);        // 连接两个链表 
-
-
+// copier 为 NULL 时浅复制；深复制时目标须持有数据（free_data 非空），否则返回失败
+bool copy_list(List* dest_list, List* src_list, copy_fn copier); // 复制到目标链表尾部
+List* clone_list(List* src_list, copy_fn copier);               // 克隆链表，深复制时副本沿用源链表的 free_data
+bool compare_lists(List* list1, List* list2);       // 比较两个链表，两者都启用指纹时先用指纹 O(1) 排除
+bool concat_lists(List* list1, List* list2);        // 把 list2 的节点整段移到 list1 尾部，list2 变为空
+
+// 有序集合运算：两个链表须按 list1->cmp 升序，重复元素按多重集合处理
+// 新建结果与源链表共享数据（结果不持有数据）；分配失败返回 NULL
+List* union_lists(List* list1, List* list2);                // 并集
+List* intersect_lists(List* list1, List* list2);            // 交集
+List* difference_lists(List* list1, List* list2);           // 差集 list1 - list2
+List* symmetric_difference_lists(List* list1, List* list2); // 对称差
+// 原地运算：结果留在 list1，list2 中需要的节点直接移入，其余节点连同数据一起删除，list2 变为空
+// 两个链表应持有同类数据（list2 的数据移入后由 list1 的 free_data 释放）
+bool union_lists_inplace(List* list1, List* list2);
+bool intersect_lists_inplace(List* list1, List* list2);
+bool difference_lists_inplace(List* list1, List* list2);
+bool symmetric_difference_lists_inplace(List* list1, List* list2);
+
+// 压缩：按链表顺序把节点搬到连续内存，恢复遍历的局部性；搬迁后原节点指针全部失效
+// payload_size > 0 时把数据一并复制到节点旁（数据须为该大小、可按字节复制且 free_data 只做释放；
+// 链表不持有数据时忽略），之后这些数据随节点块释放
+bool compact_list(List* list, size_t payload_size);                         // 一次搬迁全部节点
+bool compact_list_step(List* list, size_t max_nodes, size_t payload_size);  // 从游标处最多搬迁 max_nodes 个，返回 true 表示本轮已完成
+
+// 指纹（直接修改 node->data 的代码需自行调用 enable_fingerprint 重算）
+bool enable_fingerprint(List* list, hash_fn hash);  // 启用并按当前内容计算指纹，O(n)
+void disable_fingerprint(List* list);               // 停止维护指纹
+uint64_t get_fingerprint(List* list);               // 当前指纹，未启用时为 0
+
+// 批量比较（按值查找 / 删除 / 更新每次收集 LIST_BATCH_SIZE 个节点调用一次，NULL 表示逐个用 cmp 比较）
+void set_batch_cmp(List* list, batch_cmp_fn batch_cmp);
+
+// 延迟删除：删除只在节点上打墓碑标记（不改动链接，已取得的节点指针和遍历位置继续有效），
+// 遍历、查找、按位置访问和长度都跳过墓碑，攒够后一趟批量摘链释放。
+// purge_ratio 为 0 时只在调用 purge_tombstones、关闭延迟删除，以及排序、拼接、集合运算、压缩前清理，
+// 其间所有节点指针（含已删除的节点）都有效。purge_ratio > 0 时删除可能触发自动清理：
+// 刚删除的节点保留到下次清理，可从它继续遍历；更早删除的节点被释放，指向它们的指针随之失效。
+// 墓碑的数据在清理时才释放；指纹和过滤器在清理前仍包含墓碑
+bool enable_deferred_delete(List* list, double purge_ratio);
+void disable_deferred_delete(List* list);           // 先清理全部墓碑
+size_t purge_tombstones(List* list);                // 摘链释放所有墓碑，返回清理的个数
+bool is_tombstone(const ListNode* node);
+
+// 过滤器（按值查找 / 删除 / 更新的键须能用同一哈希函数计算；嵌入的链表需调用 disable_filter 释放）
+bool enable_filter(List* list, hash_fn hash);       // 启用并按当前内容构建过滤器，O(n)
+void disable_filter(List* list);                    // 停止维护并释放过滤器
+bool filter_may_contain(List* list, const void* key); // 为 false 时键一定不在链表中
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif    
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef __LIST_JOURNAL_H
+#define __LIST_JOURNAL_H
+
+#include "list.h"
+
+// 预写日志：链表的每次修改追加一条紧凑记录（插入附带序列化的数据，删除按位置或键，
+// 更新附带更新后的数据），重启时回放恢复内容。
+// 记录先写入内存缓冲，攒够一组（条数或等待时间）后一次 write + fdatasync（group commit），
+// 崩溃最多丢失最后一组尚未提交的修改；需要立即持久化时调用 list_journal_commit。
+// 等待时间只在有新记录或调用 list_journal_poll 时检查：一组修改之后长时间没有新修改时，
+// 要保证提交延迟不超过 group_micros，调用方须按 list_journal_poll_timeout 给出的期限调用 list_journal_poll
+// （例如作为事件循环里 poll / epoll_wait 的超时）
+// 以节点为参数的操作（insert_after_node / delete_node / update_node / detach_node 等）
+// 需要 O(n) 数出节点位置；排序、拼接到另一链表、原地集合运算等整体重排后直接用快照重写日志。
+// 启用日志的链表应持有数据（free_data 非空），按键删除 / 更新的键须能用同一序列化函数处理
+
+// 文件格式：8 字节文件头 "LJOURNAL"，随后为变长记录：
+// 操作(1) 位置(4) 键长度(4) 数据长度(4) 键 数据 校验和(4)，整数均为小端
+#define JOURNAL_RECORD_HEADER 13
+
+typedef enum {
+    JOURNAL_INSERT,         // 在位置处插入数据
+    JOURNAL_DELETE,         // 删除位置处的节点
+    JOURNAL_DELETE_KEY,     // 删除第一个与键相等的节点
+    JOURNAL_UPDATE,         // 位置处节点的数据替换为记录中的数据
+    JOURNAL_UPDATE_KEY,     // 第一个与键相等的节点的数据替换为记录中的数据
+    JOURNAL_CLEAR,          // 清空
+    JOURNAL_REVERSE,        // 反转
+    JOURNAL_OP_COUNT
+} JournalOp;
+
+typedef struct ListJournal {
+    int fd;                     // 日志文件，以追加方式打开
+    char *path;
+    serialize_fn serialize;
+    deserialize_fn deserialize;
+
+    unsigned char *buffer;      // 尚未提交的记录
+    size_t used;
+    size_t buffer_size;
+    size_t pending;             // 缓冲中的记录数
+    uint64_t pending_since;     // 缓冲中第一条记录的时间
+
+    size_t group_records;       // 攒够这么多条记录提交一次
+    uint64_t group_nanos;       // 第一条未提交的记录等待超过这么久时提交
+    bool failed;                // 序列化或写入失败，之后的修改不再记录，直到 list_journal_compact 重建日志
+
+    size_t records;             // 日志文件中的记录数（含回放的记录）
+    size_t compact_at;          // 提交后记录数超过此值时自动压缩（上次快照记录数的两倍加余量）
+    size_t commits;             // 提交（fdatasync）次数
+} ListJournal;
+
+// 打开日志：已有内容先回放到空链表（末尾不完整或校验失败的记录被截掉），之后开始记录。
+// 回放的记录数或运行中提交后的记录数超过链表长度两倍时自动压缩。group_records 为 1 时每次修改都立即提交
+bool list_journal_open(List* list, const char* path, serialize_fn serialize, deserialize_fn deserialize,
+                       size_t group_records, uint64_t group_micros);
+bool list_journal_commit(List* list);   // 立即提交缓冲中的记录
+bool list_journal_poll(List* list);     // 待提交的组等待超过 group_micros 时提交，返回本次是否提交
+int list_journal_poll_timeout(List* list); // 距离待提交的组到期的毫秒数（向上取整），没有待提交记录或未设置等待时间时为 -1
+bool list_journal_compact(List* list);  // 用当前内容的快照原子地重写日志；日志失效后调用可恢复记录
+bool list_journal_close(List* list);    // 提交并关闭，返回日志是否完整
+
+// 供 list.c 在修改时调用
+void list_journal_record(List* list, JournalOp op, int position, const void* key, const void* data);
+
+#endif
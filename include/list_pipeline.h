@@ -0,0 +1,56 @@
+#ifndef __LIST_PIPELINE_H
+#define __LIST_PIPELINE_H
+
+#include "list.h"
+
+// 惰性流水线：先登记 filter / map / update / take_while / limit 等阶段，调用终结操作
+// （count / collect / find_first / for_each）时才沿链表逻辑顺序遍历一次，每个元素依次经过所有阶段，
+// 不生成中间链表；take_while 不满足、limit 达到上限或终结操作不再需要元素时立即停止遍历。
+// 流水线是栈上的值，不分配内存，可重复执行（每次执行重新计数 limit）
+
+#define PIPE_MAX_STAGES 16
+
+typedef bool (*pipe_pred_fn)(const void *data, void *ctx);
+typedef void* (*pipe_map_fn)(void *data, void *ctx);    // 返回映射后的值，不得就地修改 data（修改源数据用 update 阶段）
+
+typedef enum {
+    PIPE_FILTER,            // 不满足条件的元素被丢弃
+    PIPE_MAP,               // 元素替换为映射结果
+    PIPE_UPDATE,            // 与 update_if 相同：源节点数据满足条件时就地更新（维护指纹、过滤器与日志），流经的值不变
+    PIPE_TAKE_WHILE,        // 第一个不满足条件的元素处结束整个遍历
+    PIPE_LIMIT,             // 最多放行 limit 个元素，之后结束遍历
+} PipeStageKind;
+
+typedef struct {
+    PipeStageKind kind;
+    pipe_pred_fn pred;      // FILTER / TAKE_WHILE
+    pipe_map_fn map;        // MAP
+    predicate_fn when;      // UPDATE 的条件，NULL 表示全部更新
+    update_fn update;       // UPDATE
+    void *ctx;              // 传给回调的上下文（UPDATE 为 new_value）
+    size_t limit;           // LIMIT 的上限
+    size_t passed;          // LIMIT 本次执行已放行的元素数
+} PipeStage;
+
+typedef struct {
+    List *list;
+    PipeStage stages[PIPE_MAX_STAGES];
+    size_t stage_count;
+    bool overflow;          // 阶段数超过上限，终结操作返回失败
+} ListPipeline;
+
+// 构建：阶段函数返回同一个流水线，便于链式书写
+ListPipeline list_pipe(List* list);
+ListPipeline* pipe_filter(ListPipeline* pipe, pipe_pred_fn pred, void* ctx);
+ListPipeline* pipe_map(ListPipeline* pipe, pipe_map_fn map, void* ctx);
+ListPipeline* pipe_update(ListPipeline* pipe, predicate_fn pred, const void* new_value, update_fn updater);
+ListPipeline* pipe_take_while(ListPipeline* pipe, pipe_pred_fn pred, void* ctx);
+ListPipeline* pipe_limit(ListPipeline* pipe, size_t limit);
+
+// 终结操作：一次遍历执行整条流水线
+size_t pipe_count(ListPipeline* pipe);                      // 到达末端的元素数
+bool pipe_collect(ListPipeline* pipe, List* dest);          // 到达末端的值依次尾插到 dest（与源共享，除非 map 生成新值）；插入失败返回 false，dest 中保留已收集的部分
+void* pipe_find_first(ListPipeline* pipe);                  // 第一个到达末端的值，没有时返回 NULL
+size_t pipe_for_each(ListPipeline* pipe, void (*fn)(void *data, void *ctx), void* ctx); // 返回处理的元素数
+
+#endif
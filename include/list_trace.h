@@ -0,0 +1,104 @@
+#ifndef __LIST_TRACE_H
+#define __LIST_TRACE_H
+
+#include "list.h"
+
+// 操作跟踪：以 -DLIST_TRACE 编译 list.c 后，每个公共操作都会写入一条定长二进制记录
+// （内部互相调用的公共操作只记录最外层一次，例如 move_to_head 不再另记摘链和挂链）
+// 未调用 list_trace_open 时，首次记录会尝试打开环境变量 LIST_TRACE_FILE 指定的文件
+// 跟踪器为全局单例，不是线程安全的
+
+typedef enum {
+    TRACE_INSERT_HEAD,
+    TRACE_INSERT_TAIL,
+    TRACE_INSERT_POSITION,
+    TRACE_INSERT_AFTER,
+    TRACE_INSERT_BEFORE,
+    TRACE_DELETE_HEAD,
+    TRACE_DELETE_TAIL,
+    TRACE_DELETE_VALUE,
+    TRACE_DELETE_POSITION,
+    TRACE_DELETE_NODE,
+    TRACE_SEARCH,
+    TRACE_SEARCH_REVERSE,
+    TRACE_GET_POSITION,
+    TRACE_GET_POSITION_REVERSE,
+    TRACE_UPDATE_VALUE,
+    TRACE_UPDATE_NODE,
+    TRACE_UPDATE_IF,
+    TRACE_CLEAR,
+    TRACE_REVERSE,
+    TRACE_SORT,                     // sort_list / sort_list_by_key / sort_list_by_bytes
+    TRACE_COPY,                     // 链表为目标，另一链表为源
+    TRACE_CLONE,                    // 链表为源，另一链表为新建的副本
+    TRACE_COMPARE,
+    TRACE_CONCAT,
+    TRACE_DETACH_NODE,
+    TRACE_ATTACH_HEAD,
+    TRACE_ATTACH_TAIL,
+    TRACE_MOVE_HEAD,
+    TRACE_MOVE_TAIL,
+    TRACE_REPLACE_NODE,
+    TRACE_UNION,
+    TRACE_INTERSECT,
+    TRACE_DIFFERENCE,
+    TRACE_SYMMETRIC_DIFFERENCE,
+    TRACE_UNION_INPLACE,
+    TRACE_INTERSECT_INPLACE,
+    TRACE_DIFFERENCE_INPLACE,
+    TRACE_SYMMETRIC_DIFFERENCE_INPLACE,
+    TRACE_MERGE,
+    TRACE_COMPACT,                  // compact_list 位置为 -1，compact_list_step 位置为 max_nodes
+    TRACE_OP_COUNT
+} TraceOp;
+
+typedef struct {
+    uint8_t op;             // TraceOp
+    uint32_t list_id;       // 链表标识（同一次运行内唯一）
+    int32_t position;       // 位置参数，无位置的操作为 -1
+    uint32_t size;          // 操作前的链表长度（不含墓碑）
+    uint32_t key_hash;      // 键 / 数据的哈希，见下；涉及两个链表的操作为另一个链表的标识
+    uint64_t timestamp;     // 距离打开跟踪文件的纳秒数
+} TraceRecord;
+
+// key_hash：链表设置了 hash 时为 hash(键 / 数据)，相等的值得到相同的 key_hash；
+// 未设置时按元素身份派生：数据参数取数据地址的哈希，按值查找 / 删除 / 更新的键先用 cmp 找到
+// 匹配的元素再取其数据地址（没有匹配时取键自身的地址），因此同一元素的插入、查找、删除记录一致，回放时查找能命中
+
+// 文件格式：8 字节文件头 "LTRACE" + 版本号，随后为定长小端记录
+#define TRACE_RECORD_BYTES 25
+
+// 记录
+bool list_trace_open(const char* path);     // 打开跟踪文件（覆盖已有内容）
+void list_trace_close(void);                // 刷新并关闭
+void list_trace_record(TraceOp op, List* list, int position, const void* key);
+size_t list_trace_count(void);              // 已记录的操作数
+
+// 回放：把跟踪逐条交给任意链表后端执行
+typedef struct {
+    const char* name;
+    void* (*create)(void);                          // 创建后端上下文
+    void (*execute)(void* ctx, const TraceRecord* record);  // 执行一条记录
+    void (*destroy)(void* ctx);                     // 销毁上下文
+} TraceBackend;
+
+typedef struct {
+    size_t ops;                         // 回放的操作数
+    size_t op_counts[TRACE_OP_COUNT];   // 各类操作的数量
+    uint64_t op_nanos[TRACE_OP_COUNT];  // 各类操作的累计耗时
+    uint64_t total_nanos;               // 总耗时
+    double ops_per_sec;                 // 吞吐量
+    uint64_t p50_nanos;                 // 单次操作延迟中位数
+    uint64_t p99_nanos;                 // 单次操作延迟 P99
+    uint64_t max_nanos;                 // 单次操作最大延迟
+} TraceReplayStats;
+
+bool list_trace_replay(const char* path, const TraceBackend* backend, TraceReplayStats* stats);
+void list_trace_print_stats(FILE* out, const char* backend_name, const TraceReplayStats* stats);
+const char* list_trace_op_name(TraceOp op);
+
+// 基于 List 的默认后端：每个 list_id 对应一个整数链表，数据为记录中的 key_hash
+// 新建结果的集合运算在回放时只执行不保留：之后对结果链表的操作回放到一个空链表上
+extern const TraceBackend list_trace_list_backend;
+
+#endif
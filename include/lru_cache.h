@@ -0,0 +1,62 @@
+#ifndef __LRU_CACHE_H
+#define __LRU_CACHE_H
+
+#include "list.h"
+
+typedef struct LRUEntry {
+    void *key;              // 键（缓存持有）
+    void *value;            // 值（缓存持有）
+    size_t bytes;           // 该条目计入容量的字节数
+    uint64_t hash;          // 键的哈希值
+    ListNode *node;         // 在最近使用链表中的节点
+    struct LRUEntry *chain; // 同一哈希桶中的下一个条目
+} LRUEntry;
+
+typedef struct {
+    size_t hits;            // 命中次数
+    size_t misses;          // 未命中次数
+    size_t evictions;       // 因容量限制被淘汰的条目数
+} LRUStats;
+
+typedef struct {
+    List list;                  // 最近使用的条目在头部，最久未使用的在尾部
+    LRUEntry **buckets;         // 键索引（链地址法）
+    size_t bucket_count;        // 桶数，始终为 2 的幂
+    size_t max_entries;         // 条目数上限，0 表示不限
+    size_t max_bytes;           // 字节数上限，0 表示不限
+    size_t bytes;               // 当前字节数
+    LRUStats stats;
+
+    // 函数指针
+    hash_fn hash;                               // 键哈希
+    int (*key_cmp)(const void *a, const void *b);// 键比较
+    void (*free_key)(void *key);                // 销毁键
+    void (*free_value)(void *value);            // 销毁值
+} LRUCache;
+
+// 创建缓存，max_entries / max_bytes 为 0 表示对应维度不限
+LRUCache* lru_create(hash_fn hash, int (*key_cmp)(const void *, const void *),
+                     void (*free_key)(void *), void (*free_value)(void *),
+                     size_t max_entries, size_t max_bytes);
+
+// 查找：命中时把条目移到头部并返回值，未命中返回 NULL
+void* lru_get(LRUCache* cache, const void* key);
+// 查找但不影响最近使用顺序与统计
+void* lru_peek(LRUCache* cache, const void* key);
+
+// 插入或替换，成功后缓存接管 key 与 value；超出容量时从尾部淘汰。
+// 替换时释放传入的重复键和旧值，传入的正是缓存中的键或值时保留（可用来只更新字节数）
+// 单个条目超过 max_bytes 时返回 false，所有权仍归调用者
+bool lru_put(LRUCache* cache, void* key, void* value, size_t bytes);
+
+bool lru_remove(LRUCache* cache, const void* key); // 删除指定键
+bool lru_evict_tail(LRUCache* cache);              // 淘汰最久未使用的条目
+
+size_t lru_size(LRUCache* cache);       // 条目数
+size_t lru_bytes(LRUCache* cache);      // 当前字节数
+LRUStats lru_stats(LRUCache* cache);    // 命中 / 未命中 / 淘汰统计
+
+void lru_clear(LRUCache* cache);        // 清空缓存
+void lru_destroy(LRUCache* cache);      // 销毁缓存
+
+#endif
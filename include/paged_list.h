@@ -0,0 +1,77 @@
+#ifndef __PAGED_LIST_H
+#define __PAGED_LIST_H
+
+#include "list.h"
+
+// 分页链表：连续元素按固定容量分页，最多 max_hot_pages 个页驻留内存（LRU），
+// 其余页序列化后换出到本地文件。换出依赖操作系统页缓存延迟落盘（write-behind），
+// 顺序遍历时对下一页发出预读提示（read-ahead）。
+// 删除的页和变大后搬走的页留下的文件空间记入空闲区间表，之后写出的页优先复用，位于文件末尾的直接截掉
+
+typedef struct {
+    void **items;           // 驻留内存时的元素数组，换出后为 NULL
+    size_t count;           // 元素个数
+    bool dirty;             // 内存中的内容比文件新
+    long offset;            // 在文件中的位置，从未写出时为 -1
+    size_t stored;          // 文件中内容的字节数
+    size_t reserved;        // 文件中为该页预留的字节数
+    ListNode *node;         // 在页序列中的节点
+    ListNode *hot;          // 在热页链表中的节点，未驻留时为 NULL
+} Page;
+
+typedef struct {
+    long offset;            // 空闲区间在文件中的起点
+    size_t length;          // 空闲区间的字节数
+} Extent;
+
+typedef struct {
+    List pages;             // 页序列，node->data 为 Page*
+    List hot;               // 驻留内存的页，最近使用的在头部
+    size_t size;            // 元素总数
+    size_t page_capacity;   // 每页元素数
+    size_t max_hot_pages;   // 驻留内存的页数上限
+
+    int fd;                 // 换出文件
+    char *path;             // 换出文件路径，销毁时删除
+    long file_end;          // 文件末尾
+    List extents;           // 文件中可复用的空闲区间，按偏移递增且互不相邻，node->data 为 Extent*
+    unsigned char *buffer;  // 序列化缓冲区
+    size_t buffer_size;
+
+    size_t page_ins;        // 从文件换入的页数
+    size_t page_outs;       // 写出到文件的页数
+
+    // 函数指针
+    serialize_fn serialize;
+    deserialize_fn deserialize;
+    void (*free_data)(void *data);
+} PagedList;
+
+typedef struct {
+    PagedList *list;
+    ListNode *page;         // 当前页
+    size_t index;           // 当前页内下标
+} PagedIterator;
+
+PagedList* paged_list_create(const char* path, size_t page_capacity, size_t max_hot_pages,
+                             serialize_fn serialize, deserialize_fn deserialize,
+                             void (*free_data)(void *));
+
+// 头尾操作；弹出时数据所有权交给调用者
+bool paged_list_push_back(PagedList* list, void* data);
+bool paged_list_push_front(PagedList* list, void* data);
+void* paged_list_pop_front(PagedList* list);
+void* paged_list_pop_back(PagedList* list);
+
+// 随机访问：返回的指针在下一次调用分页链表的函数之前有效
+void* paged_list_get(PagedList* list, size_t index);
+
+// 顺序遍历：返回的指针在迭代器前进到下一页之前有效
+PagedIterator paged_list_begin(PagedList* list);
+void* paged_list_next(PagedIterator* it);   // 到末尾返回 NULL
+
+size_t paged_list_size(PagedList* list);
+size_t paged_list_hot_pages(PagedList* list);
+void paged_list_destroy(PagedList* list);
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef __SHARDED_LIST_H
+#define __SHARDED_LIST_H
+
+#include <pthread.h>
+#include "list.h"
+
+// 分片链表：每个线程固定写入自己的分片，尾插只竞争本分片的锁（线程数不超过分片数时无竞争）
+// 全局操作逐个锁定分片读取；collect 通过 concat_lists 整段移动，每个分片 O(1)
+
+#define SHARD_CACHE_LINE 64
+
+typedef struct {
+    pthread_mutex_t lock;   // 仅在多个线程映射到同一分片或执行全局操作时有竞争
+    List list;              // 分片内的线程本地链表
+} __attribute__((aligned(SHARD_CACHE_LINE))) ListShard;
+
+typedef struct {
+    ListShard *shards;
+    size_t shard_count;
+
+    // 函数指针
+    int (*cmp)(const void *a, const void *b);
+    void (*free_data)(void *data);
+} ShardedList;
+
+ShardedList* sharded_list_create(size_t shard_count,
+                                 int (*cmp)(const void *, const void *),
+                                 void (*free_data)(void *));
+
+ListShard* sharded_list_local(ShardedList* list);           // 当前线程的分片
+ListNode* sharded_list_insert(ShardedList* list, void* data);// 尾插到当前线程的分片
+
+size_t sharded_list_size(ShardedList* list);                // 所有分片的元素总数
+void sharded_list_for_each(ShardedList* list, void (*fn)(void *data, void *ctx), void* ctx);
+void* sharded_list_search(ShardedList* list, const void* key); // 返回第一个匹配的数据
+bool sharded_list_collect(ShardedList* list, List* dest);   // 把所有分片移到 dest 尾部
+
+void sharded_list_destroy(ShardedList* list);
+
+#endif
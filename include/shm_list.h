@@ -0,0 +1,81 @@
+#ifndef __SHM_LIST_H
+#define __SHM_LIST_H
+
+#include <pthread.h>
+#include "list.h"
+
+// 共享内存链表：表头、节点与数据全部位于一个 POSIX 共享内存段中，多个进程挂接同一个段后
+// 直接在段内插入、删除、遍历，无需序列化。节点之间用相对段起始的偏移代替指针，
+// 各进程可以把段映射到不同地址。
+// 段内按创建时给定的数据大小切分定长槽位（节点后紧跟数据），空闲槽位串成空闲链表；
+// 容量在创建时固定。所有修改由进程间共享的健壮递归互斥锁保护：持锁进程崩溃后，
+// 下一个加锁者沿 next 链修复 prev / tail / size
+
+typedef uint64_t shm_off_t;     // 段内偏移，0 表示空
+
+typedef struct {
+    shm_off_t prev;             // 前驱节点偏移
+    shm_off_t next;             // 后继节点偏移（空闲槽位复用为空闲链表）
+    size_t length;              // 数据的实际字节数
+} ShmNode;
+
+typedef struct {
+    uint64_t magic;             // 挂接时校验段格式
+    size_t segment_size;        // 段的总字节数
+    pthread_mutex_t lock;       // PTHREAD_PROCESS_SHARED | ROBUST | RECURSIVE
+
+    shm_off_t head;             // 头节点偏移
+    shm_off_t tail;             // 尾节点偏移
+    size_t size;                // 链表长度
+
+    // 段内分配器
+    size_t payload_size;        // 每个节点可容纳的数据字节数
+    size_t slot_size;           // 槽位间距（节点 + 数据，按 max_align_t 对齐）
+    size_t capacity;            // 槽位总数
+    size_t carved;              // 已从未用区域切出的槽位数，其后的槽位从未使用
+    shm_off_t free_slots;       // 已释放槽位组成的链表
+    shm_off_t slots;            // 第一个槽位的偏移
+} ShmListHeader;
+
+// 进程本地的句柄：每个进程各自持有，记录本进程的映射地址
+typedef struct {
+    ShmListHeader *header;      // 段在本进程中的映射地址
+    char *name;                 // 共享内存对象名（以 / 开头）
+} ShmList;
+
+// 创建新的共享内存链表（同名对象已存在时失败）；挂接已有的链表
+ShmList* shm_list_create(const char* name, size_t capacity, size_t payload_size);
+ShmList* shm_list_attach(const char* name);
+void shm_list_detach(ShmList* list);    // 解除本进程的映射，链表保留
+void shm_list_destroy(ShmList* list);   // 解除映射并删除共享内存对象，已挂接的进程可继续使用直到解除映射
+
+// 加锁后可连续执行多个操作或遍历；锁可重入，持锁时仍可调用下面的修改函数
+bool shm_list_lock(ShmList* list);
+void shm_list_unlock(ShmList* list);
+
+// 零拷贝插入：先分配游离节点并直接写入数据，再挂到链表中
+ShmNode* shm_list_alloc(ShmList* list, size_t length);  // length 不超过 payload_size，槽位耗尽时返回 NULL
+void shm_list_free(ShmList* list, ShmNode* node);       // 释放未挂入链表的节点
+bool shm_list_attach_tail(ShmList* list, ShmNode* node);
+bool shm_list_attach_head(ShmList* list, ShmNode* node);
+
+// 复制插入 / 删除（各自加锁）
+ShmNode* shm_list_insert_tail(ShmList* list, const void* data, size_t length);
+ShmNode* shm_list_insert_head(ShmList* list, const void* data, size_t length);
+bool shm_list_delete(ShmList* list, ShmNode* node);
+size_t shm_list_pop_head(ShmList* list, void* buf, size_t capacity); // 复制出头节点数据并删除，返回数据长度，空链表返回 0
+
+// 遍历与访问：调用者须持锁，返回的节点只在持锁期间有效
+ShmNode* shm_list_first(ShmList* list);
+ShmNode* shm_list_last(ShmList* list);
+ShmNode* shm_list_next(ShmList* list, ShmNode* node);
+ShmNode* shm_list_prev(ShmList* list, ShmNode* node);
+void* shm_node_data(ShmNode* node);     // 节点旁的数据，可直接读写
+
+// 按值查找：cmp 比较节点数据与 key，调用者须持锁
+ShmNode* shm_list_search(ShmList* list, const void* key, int (*cmp)(const void *, const void *));
+
+size_t shm_list_size(ShmList* list);
+size_t shm_list_free_slots(ShmList* list);  // 剩余可分配的槽位数
+
+#endif
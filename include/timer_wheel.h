@@ -0,0 +1,52 @@
+#ifndef __TIMER_WHEEL_H
+#define __TIMER_WHEEL_H
+
+#include <stdint.h>
+#include "list.h"
+
+// 分层时间轮：第 0 层 256 个槽，其余 4 层各 64 个槽，共覆盖 2^32 个 tick
+#define TW_ROOT_BITS   8
+#define TW_LEVEL_BITS  6
+#define TW_LEVELS      4
+#define TW_ROOT_SIZE   (1 << TW_ROOT_BITS)
+#define TW_LEVEL_SIZE  (1 << TW_LEVEL_BITS)
+#define TW_MAX_DELTA   ((((uint64_t)1) << (TW_ROOT_BITS + TW_LEVELS * TW_LEVEL_BITS)) - 1)
+
+typedef struct TimerWheel TimerWheel;
+
+typedef struct Timer {
+    uint64_t expires;       // 到期时刻（tick）
+    void *data;             // 用户数据
+    ListNode *node;         // 所在槽位中的节点，用于 O(1) 摘除
+    List *slot;             // 当前所在槽位
+    TimerWheel *wheel;      // 所属时间轮
+} Timer;
+
+struct TimerWheel {
+    uint64_t current;                       // 下一个待处理的 tick
+    size_t count;                           // 挂起的定时器数量
+    size_t level_count[TW_LEVELS + 1];      // 各层挂起的定时器数量，用于跳过空转的 tick
+    void (*free_data)(void *data);          // 销毁用户数据
+    List root[TW_ROOT_SIZE];                // 第 0 层：逐 tick 到期
+    List levels[TW_LEVELS][TW_LEVEL_SIZE];  // 第 1~4 层：到点时逐级下放
+};
+
+// 创建时间轮，now 为当前 tick
+TimerWheel* timer_wheel_create(uint64_t now, void (*free_data)(void *));
+
+// 调度 / 取消（均为 O(1)）
+// 定时器到期后（数据出现在 advance 的 expired 中）Timer 即被释放，不得再 reschedule / cancel：
+// 调用方保存的 Timer* 须在处理到期数据时一并清除
+Timer* timer_wheel_schedule(TimerWheel* wheel, uint64_t expires, void* data);   // 在 expires 时刻到期
+bool timer_wheel_reschedule(TimerWheel* wheel, Timer* timer, uint64_t expires); // 修改到期时刻
+bool timer_wheel_cancel(TimerWheel* wheel, Timer* timer);                       // 取消并释放用户数据
+
+// 推进到 now（含），tick UINT64_MAX 保留不用：now 超出时按 UINT64_MAX - 1 处理，到期时刻为 UINT64_MAX 的定时器永不到期
+// 把所有到期的用户数据按到期顺序挂到 expired 尾部，返回到期数量
+// expired 中的节点直接复用时间轮内的节点，数据所有权随之转移给 expired
+size_t timer_wheel_advance(TimerWheel* wheel, uint64_t now, List* expired);
+
+size_t timer_wheel_pending(TimerWheel* wheel);  // 挂起的定时器数量
+void timer_wheel_destroy(TimerWheel* wheel);    // 销毁时间轮（释放所有挂起的数据）
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef __WS_DEQUE_H
+#define __WS_DEQUE_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include "list.h"
+
+// Chase-Lev 工作窃取双端队列：所有者在底部无锁 push / pop，窃取者用 CAS 从顶部窃取
+// 元素不能为 NULL（NULL 表示队列为空或窃取失败）
+
+typedef struct WSArray {
+    size_t capacity;            // 2 的幂
+    struct WSArray *retired;    // 扩容后被替换的旧数组，销毁时统一释放（窃取者可能仍在读取）
+    _Atomic(void *) items[];
+} WSArray;
+
+typedef struct {
+    _Atomic int64_t top;                                        // 窃取端
+    char pad[64 - sizeof(int64_t)];                             // 避免与所有者端伪共享
+    _Atomic int64_t bottom;                                     // 所有者端
+    _Atomic(WSArray *) array;
+} WSDeque;
+
+bool ws_deque_init(WSDeque* deque, size_t capacity);
+void ws_deque_destroy(WSDeque* deque);
+
+bool ws_deque_push(WSDeque* deque, void* item);     // 仅所有者线程调用
+void* ws_deque_pop(WSDeque* deque);                 // 仅所有者线程调用，后进先出
+void* ws_deque_steal(WSDeque* deque);               // 任意线程调用，先进先出；竞争失败返回 NULL
+size_t ws_deque_size(WSDeque* deque);               // 近似大小
+
+// ==================== 工作线程池 ====================
+// 每个工作线程有一个工作窃取队列；工作线程内提交的任务进入本线程队列，
+// 外部线程提交的任务进入一个由互斥锁保护的注入链表
+
+typedef void (*task_fn)(void *arg);
+
+typedef struct WorkerPool WorkerPool;
+
+typedef struct {
+    WorkerPool *pool;
+    size_t index;
+    pthread_t thread;
+    WSDeque deque;
+    unsigned int seed;          // 随机选择窃取目标
+    size_t executed;            // 执行的任务数
+    size_t stolen;              // 窃取成功的任务数
+} Worker;
+
+struct WorkerPool {
+    Worker *workers;
+    size_t worker_count;
+
+    pthread_mutex_t lock;       // 保护注入链表与睡眠
+    pthread_cond_t wakeup;      // 有新任务或需要退出时唤醒空闲线程
+    pthread_cond_t idle;        // 所有任务完成时唤醒等待者
+    List injected;              // 外部提交的任务
+    atomic_size_t injected_count; // 注入链表长度，供工作线程无锁检查
+
+    atomic_size_t pending;      // 已提交未完成的任务数
+    atomic_size_t sleeping;     // 正在睡眠的工作线程数
+    atomic_bool stopping;
+};
+
+WorkerPool* worker_pool_create(size_t worker_count);
+bool worker_pool_submit(WorkerPool* pool, task_fn fn, void* arg);  // 可在任意线程调用
+void worker_pool_wait(WorkerPool* pool);                            // 等待所有已提交任务完成
+void worker_pool_destroy(WorkerPool* pool);                         // 等待完成后停止并销毁
+
+#endif
@@ -0,0 +1,878 @@
+#include <string.h>
+#include "adaptive_list.h"
+
+#define RING_MIN_CAPACITY 16
+#define CHUNK_BUILD_FILL (ADAPTIVE_CHUNK * 3 / 4)   // 整体重建时每块的元素数，留出插入的余量
+
+// ==================== 链表表示 ====================
+
+// 从较近的一端数到第 position 个节点
+static ListNode* linked_node_at(AdaptiveList* list, size_t position) {
+    if (position < list->size / 2) {
+        return get_node_at_position(&list->linked, (int)position);
+    }
+    return get_node_at_position_reverse(&list->linked, (int)(list->size - 1 - position));
+}
+
+static bool linked_insert(AdaptiveList* list, size_t position, void* data) {
+    if (position == list->size) {
+        return insert_at_tail(&list->linked, data) != NULL;
+    }
+    return insert_before_node(&list->linked, linked_node_at(list, position), data) != NULL;
+}
+
+static void* linked_remove(AdaptiveList* list, ListNode* node) {
+    void* data = node->data;
+    delete_node(&list->linked, node);
+    return data;
+}
+
+// ==================== 环形缓冲区表示 ====================
+
+static void** ring_slot(AdaptiveList* list, size_t index) {
+    return &list->ring[(list->ring_head + index) & (list->ring_capacity - 1)];
+}
+
+// 按顺序搬到新缓冲区，容量翻倍
+static bool ring_reserve(AdaptiveList* list, size_t needed) {
+    if (needed <= list->ring_capacity) return true;
+
+    size_t capacity = list->ring_capacity ? list->ring_capacity : RING_MIN_CAPACITY;
+    while (capacity < needed) {
+        capacity *= 2;
+    }
+    void** ring = malloc(capacity * sizeof(void*));
+    if (!ring) return false;
+
+    for (size_t i = 0; i < list->size; i++) {
+        ring[i] = *ring_slot(list, i);
+    }
+    free(list->ring);
+    list->ring = ring;
+    list->ring_head = 0;
+    list->ring_capacity = capacity;
+    return true;
+}
+
+// 移动离插入点较近的一侧
+static bool ring_insert(AdaptiveList* list, size_t position, void* data) {
+    if (!ring_reserve(list, list->size + 1)) return false;
+
+    if (position < list->size - position) {
+        list->ring_head = (list->ring_head - 1) & (list->ring_capacity - 1);
+        for (size_t i = 0; i < position; i++) {
+            *ring_slot(list, i) = *ring_slot(list, i + 1);
+        }
+    } else {
+        for (size_t i = list->size; i > position; i--) {
+            *ring_slot(list, i) = *ring_slot(list, i - 1);
+        }
+    }
+    *ring_slot(list, position) = data;
+    return true;
+}
+
+static void* ring_remove(AdaptiveList* list, size_t position) {
+    void* data = *ring_slot(list, position);
+
+    if (position < list->size - 1 - position) {
+        for (size_t i = position; i > 0; i--) {
+            *ring_slot(list, i) = *ring_slot(list, i - 1);
+        }
+        list->ring_head = (list->ring_head + 1) & (list->ring_capacity - 1);
+    } else {
+        for (size_t i = position; i + 1 < list->size; i++) {
+            *ring_slot(list, i) = *ring_slot(list, i + 1);
+        }
+    }
+    return data;
+}
+
+// ==================== 分块表示 ====================
+
+static bool chunk_dir_insert(AdaptiveList* list, size_t index, AdaptiveChunk* chunk) {
+    if (list->chunk_count == list->chunk_slots) {
+        size_t slots = list->chunk_slots ? list->chunk_slots * 2 : 8;
+        AdaptiveChunk** chunks = realloc(list->chunks, slots * sizeof(AdaptiveChunk*));
+        if (!chunks) return false;
+        list->chunks = chunks;
+        list->chunk_slots = slots;
+    }
+
+    memmove(list->chunks + index + 1, list->chunks + index,
+            (list->chunk_count - index) * sizeof(AdaptiveChunk*));
+    list->chunks[index] = chunk;
+    list->chunk_count++;
+    return true;
+}
+
+static void chunk_dir_remove(AdaptiveList* list, size_t index) {
+    free(list->chunks[index]);
+    memmove(list->chunks + index, list->chunks + index + 1,
+            (list->chunk_count - index - 1) * sizeof(AdaptiveChunk*));
+    list->chunk_count--;
+}
+
+// 第 position 个元素所在的块与块内下标，从较近的一端数块；position == size 时为最后一块的末尾
+static void chunk_locate(AdaptiveList* list, size_t position, size_t* chunk, size_t* offset) {
+    size_t c = 0;
+    size_t off = position;
+    if (position <= list->size / 2) {
+        while (c < list->chunk_count && off >= list->chunks[c]->count) {
+            off -= list->chunks[c]->count;
+            c++;
+        }
+    } else {
+        size_t remaining = list->size - position;   // 从 position 起到末尾的元素数
+        size_t after = 0;                           // c 之后各块的元素数
+        c = list->chunk_count - 1;
+        while (after + list->chunks[c]->count < remaining) {
+            after += list->chunks[c]->count;
+            c--;
+        }
+        off = list->chunks[c]->count - (remaining - after);
+    }
+    *chunk = c;
+    *offset = off;
+}
+
+// 插入到 chunk 块的 offset 处（offset 可等于块内元素数）；满块在两端插入时新建块，中间插入时对半拆分。
+// 返回新元素的位置
+static bool chunked_insert_at(AdaptiveList* list, size_t chunk, size_t offset, void* data,
+                              size_t* out_chunk, size_t* out_offset) {
+    AdaptiveChunk* target = list->chunk_count ? list->chunks[chunk] : NULL;
+
+    if (!target || target->count == ADAPTIVE_CHUNK) {
+        AdaptiveChunk* fresh = malloc(sizeof(AdaptiveChunk));
+        if (!fresh) return false;
+        fresh->count = 0;
+
+        size_t index = chunk;
+        if (target && offset == ADAPTIVE_CHUNK) {
+            index = chunk + 1;
+        } else if (target && offset > 0) {
+            // 对半拆分，后一半移入新块
+            size_t half = ADAPTIVE_CHUNK / 2;
+            memcpy(fresh->items, target->items + half, (ADAPTIVE_CHUNK - half) * sizeof(void*));
+            fresh->count = ADAPTIVE_CHUNK - half;
+            index = chunk + 1;
+        }
+        if (!chunk_dir_insert(list, index, fresh)) {
+            free(fresh);
+            return false;
+        }
+
+        if (fresh->count > 0) {
+            target->count = ADAPTIVE_CHUNK / 2;
+            if (offset > target->count) {
+                chunk = index;
+                offset -= target->count;
+            }
+        } else {
+            chunk = index;
+            offset = 0;
+        }
+        target = list->chunks[chunk];
+    }
+
+    memmove(target->items + offset + 1, target->items + offset, (target->count - offset) * sizeof(void*));
+    target->items[offset] = data;
+    target->count++;
+    *out_chunk = chunk;
+    *out_offset = offset;
+    return true;
+}
+
+static bool chunked_insert(AdaptiveList* list, size_t position, void* data) {
+    size_t chunk = 0;
+    size_t offset = 0;
+    if (list->chunk_count) chunk_locate(list, position, &chunk, &offset);
+    return chunked_insert_at(list, chunk, offset, data, &chunk, &offset);
+}
+
+// 删除后块为空时整块释放；返回是否释放了块
+static void* chunked_remove_at(AdaptiveList* list, size_t chunk, size_t offset, bool* dropped) {
+    AdaptiveChunk* target = list->chunks[chunk];
+    void* data = target->items[offset];
+
+    target->count--;
+    memmove(target->items + offset, target->items + offset + 1, (target->count - offset) * sizeof(void*));
+    *dropped = target->count == 0;
+    if (*dropped) chunk_dir_remove(list, chunk);
+    return data;
+}
+
+// ==================== 按表示分派 ====================
+
+static bool insert_at(AdaptiveList* list, size_t position, void* data) {
+    bool ok = false;
+    switch (list->repr) {
+    case ADAPTIVE_LINKED:
+        ok = linked_insert(list, position, data);
+        break;
+    case ADAPTIVE_RING:
+        ok = ring_insert(list, position, data);
+        break;
+    case ADAPTIVE_CHUNKED:
+        ok = chunked_insert(list, position, data);
+        break;
+    default:
+        break;
+    }
+    if (ok) {
+        list->size++;
+        list->version++;
+    }
+    return ok;
+}
+
+static void* remove_at(AdaptiveList* list, size_t position) {
+    void* data = NULL;
+    switch (list->repr) {
+    case ADAPTIVE_LINKED:
+        data = linked_remove(list, linked_node_at(list, position));
+        break;
+    case ADAPTIVE_RING:
+        data = ring_remove(list, position);
+        break;
+    case ADAPTIVE_CHUNKED: {
+        size_t chunk, offset;
+        bool dropped;
+        chunk_locate(list, position, &chunk, &offset);
+        data = chunked_remove_at(list, chunk, offset, &dropped);
+        break;
+    }
+    default:
+        break;
+    }
+    list->size--;
+    list->version++;
+    return data;
+}
+
+static void* get_at(AdaptiveList* list, size_t position) {
+    switch (list->repr) {
+    case ADAPTIVE_LINKED:
+        return linked_node_at(list, position)->data;
+    case ADAPTIVE_RING:
+        return *ring_slot(list, position);
+    case ADAPTIVE_CHUNKED: {
+        size_t chunk, offset;
+        chunk_locate(list, position, &chunk, &offset);
+        return list->chunks[chunk]->items[offset];
+    }
+    default:
+        return NULL;
+    }
+}
+
+// 按顺序对每个元素调用 fn，fn 返回 false 时停止；返回停止处的位置，全部访问完返回 size
+static size_t visit(AdaptiveList* list, bool (*fn)(void *data, void *ctx), void* ctx) {
+    size_t index = 0;
+    switch (list->repr) {
+    case ADAPTIVE_LINKED:
+        for (ListNode* node = get_first_node(&list->linked); node; node = get_next_node(&list->linked, node), index++) {
+            if (!fn(node->data, ctx)) return index;
+        }
+        break;
+    case ADAPTIVE_RING:
+        for (; index < list->size; index++) {
+            if (!fn(*ring_slot(list, index), ctx)) return index;
+        }
+        break;
+    case ADAPTIVE_CHUNKED:
+        for (size_t c = 0; c < list->chunk_count; c++) {
+            AdaptiveChunk* chunk = list->chunks[c];
+            for (size_t i = 0; i < chunk->count; i++, index++) {
+                if (!fn(chunk->items[i], ctx)) return index;
+            }
+        }
+        break;
+    default:
+        break;
+    }
+    return list->size;
+}
+
+// 释放当前表示占用的结构（不释放数据）
+static void release_repr(AdaptiveList* list) {
+    clear_list(&list->linked);
+
+    free(list->ring);
+    list->ring = NULL;
+    list->ring_head = 0;
+    list->ring_capacity = 0;
+
+    for (size_t c = 0; c < list->chunk_count; c++) {
+        free(list->chunks[c]);
+    }
+    free(list->chunks);
+    list->chunks = NULL;
+    list->chunk_count = 0;
+    list->chunk_slots = 0;
+}
+
+// ==================== 代价模型与迁移 ====================
+// 代价单位约为一次缓存未命中的指针访问；连续内存中移动 / 扫描 8 个指针计为 1
+
+typedef enum {
+    OP_HEAD,            // 头插 / 头删
+    OP_TAIL,            // 尾插 / 尾删
+    OP_GET,             // 按位置读取
+    OP_EDIT,            // 按位置插入 / 删除
+    OP_SCAN,            // 顺序扫描 count 个元素
+    OP_STEP,            // 游标前进一步
+    OP_CURSOR_EDIT,     // 游标处插入 / 删除
+} AdaptiveOp;
+
+static void op_cost(AdaptiveList* list, AdaptiveOp op, size_t position, size_t count, double* cost) {
+    double n = (double)list->size;
+    double near = position < list->size - position ? (double)position : n - (double)position;
+    double half_chunk = ADAPTIVE_CHUNK / 16.0;  // 块内平均移动半块
+
+    switch (op) {
+    case OP_HEAD:
+    case OP_TAIL:
+        cost[ADAPTIVE_LINKED] = 2;                                  // 节点分配 / 释放
+        cost[ADAPTIVE_RING] = 1;
+        cost[ADAPTIVE_CHUNKED] = op == OP_HEAD ? 1 + ADAPTIVE_CHUNK / 8.0 : 1;
+        break;
+    case OP_GET:
+        cost[ADAPTIVE_LINKED] = 1 + near;
+        cost[ADAPTIVE_RING] = 1;
+        cost[ADAPTIVE_CHUNKED] = 1 + near / ADAPTIVE_CHUNK;
+        break;
+    case OP_EDIT:
+        cost[ADAPTIVE_LINKED] = 2 + near;
+        cost[ADAPTIVE_RING] = 1 + near / 8;
+        cost[ADAPTIVE_CHUNKED] = 1 + near / ADAPTIVE_CHUNK + half_chunk;
+        break;
+    case OP_SCAN:
+        cost[ADAPTIVE_LINKED] = (double)count;
+        cost[ADAPTIVE_RING] = 1 + count / 4.0;                      // 仍需访问每个数据
+        cost[ADAPTIVE_CHUNKED] = 1 + count / 4.0 + (double)count / ADAPTIVE_CHUNK;
+        break;
+    case OP_STEP:
+        cost[ADAPTIVE_LINKED] = 1;
+        cost[ADAPTIVE_RING] = 1 / 8.0;
+        cost[ADAPTIVE_CHUNKED] = 1 / 8.0;
+        break;
+    case OP_CURSOR_EDIT:
+        cost[ADAPTIVE_LINKED] = 2;
+        cost[ADAPTIVE_RING] = 1 + near / 8;
+        cost[ADAPTIVE_CHUNKED] = 1 + half_chunk;
+        break;
+    }
+}
+
+// 迁移需要搬移全部元素指针，涉及链表时每个元素还要分配或释放节点
+static double migration_cost(AdaptiveList* list, AdaptiveRepr to) {
+    double n = (double)list->size;
+    return list->repr == ADAPTIVE_LINKED || to == ADAPTIVE_LINKED ? 2 * n : n / 8;
+}
+
+static void end_window(AdaptiveList* list) {
+    AdaptiveRepr best = list->repr;
+    for (int r = 0; r < ADAPTIVE_REPR_COUNT; r++) {
+        if (list->cost[r] < list->cost[best]) best = (AdaptiveRepr)r;
+    }
+
+    double saving = list->cost[list->repr] - list->cost[best];
+    if (best == list->repr || saving <= list->cost[list->repr] * ADAPTIVE_MARGIN) {
+        list->streak = 0;
+        list->savings = 0;
+    } else if (best == list->candidate && list->streak > 0) {
+        list->streak++;
+        list->savings += saving;
+    } else {
+        list->candidate = best;
+        list->streak = 1;
+        list->savings = saving;
+    }
+
+    if (list->streak >= ADAPTIVE_CONFIRM && list->savings > migration_cost(list, best)) {
+        adaptive_list_convert(list, best);
+    }
+
+    memset(list->cost, 0, sizeof(list->cost));
+    list->window_ops = 0;
+}
+
+// 操作完成后记录代价，窗口结束时决定是否迁移
+static void record(AdaptiveList* list, AdaptiveOp op, size_t position, size_t count) {
+    if (!list->adaptive) return;
+
+    double cost[ADAPTIVE_REPR_COUNT];
+    op_cost(list, op, position, count, cost);
+    for (int r = 0; r < ADAPTIVE_REPR_COUNT; r++) {
+        list->cost[r] += cost[r];
+    }
+    if (++list->window_ops == ADAPTIVE_WINDOW) end_window(list);
+}
+
+static bool export_item(void* data, void* ctx) {
+    void*** out = ctx;
+    *(*out)++ = data;
+    return true;
+}
+
+// 用按顺序排列的元素建立目标表示；失败时目标表示的结构已释放
+static bool build_repr(AdaptiveList* list, AdaptiveRepr repr, void** items, size_t count) {
+    switch (repr) {
+    case ADAPTIVE_LINKED:
+        for (size_t i = 0; i < count; i++) {
+            if (!insert_at_tail(&list->linked, items[i])) {
+                clear_list(&list->linked);
+                return false;
+            }
+        }
+        return true;
+    case ADAPTIVE_RING: {
+        size_t capacity = RING_MIN_CAPACITY;
+        while (capacity < count) {
+            capacity *= 2;
+        }
+        void** ring = malloc(capacity * sizeof(void*));
+        if (!ring) return false;
+        memcpy(ring, items, count * sizeof(void*));
+        list->ring = ring;
+        list->ring_head = 0;
+        list->ring_capacity = capacity;
+        return true;
+    }
+    case ADAPTIVE_CHUNKED: {
+        size_t chunks = (count + CHUNK_BUILD_FILL - 1) / CHUNK_BUILD_FILL;
+        list->chunks = malloc((chunks ? chunks : 1) * sizeof(AdaptiveChunk*));
+        if (!list->chunks) return false;
+        list->chunk_slots = chunks ? chunks : 1;
+        for (size_t i = 0; i < count; i += CHUNK_BUILD_FILL) {
+            AdaptiveChunk* chunk = malloc(sizeof(AdaptiveChunk));
+            if (!chunk) {
+                for (size_t c = 0; c < list->chunk_count; c++) {
+                    free(list->chunks[c]);
+                }
+                free(list->chunks);
+                list->chunks = NULL;
+                list->chunk_count = 0;
+                list->chunk_slots = 0;
+                return false;
+            }
+            chunk->count = count - i < CHUNK_BUILD_FILL ? count - i : CHUNK_BUILD_FILL;
+            memcpy(chunk->items, items + i, chunk->count * sizeof(void*));
+            list->chunks[list->chunk_count++] = chunk;
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+// ==================== 创建 / 销毁 ====================
+
+AdaptiveList* adaptive_list_create(int (*cmp)(const void *, const void *), void (*free_data)(void *)) {
+    AdaptiveList* list = calloc(1, sizeof(AdaptiveList));
+    if (!list) return NULL;
+
+    init_list_inplace(&list->linked, cmp, NULL);
+    list->repr = ADAPTIVE_LINKED;
+    list->adaptive = true;
+    list->candidate = ADAPTIVE_LINKED;
+    list->cmp = cmp;
+    list->free_data = free_data;
+    return list;
+}
+
+void adaptive_list_destroy(AdaptiveList* list) {
+    if (!list) return;
+    adaptive_clear(list);
+    free(list);
+}
+
+static bool free_item(void* data, void* ctx) {
+    ((AdaptiveList*)ctx)->free_data(data);
+    return true;
+}
+
+void adaptive_clear(AdaptiveList* list) {
+    if (!list) return;
+    if (list->free_data) visit(list, free_item, list);
+    release_repr(list);
+    list->size = 0;
+    list->version++;
+}
+
+// ==================== 表示控制 ====================
+
+AdaptiveRepr adaptive_list_repr(AdaptiveList* list) {
+    return list ? list->repr : ADAPTIVE_LINKED;
+}
+
+bool adaptive_list_convert(AdaptiveList* list, AdaptiveRepr repr) {
+    if (!list || repr >= ADAPTIVE_REPR_COUNT) return false;
+    if (repr == list->repr) return true;
+
+    void** items = malloc((list->size ? list->size : 1) * sizeof(void*));
+    if (!items) return false;
+    void** out = items;
+    visit(list, export_item, &out);
+
+    // 先建好新表示再释放旧表示，失败时保持原样
+    AdaptiveRepr old = list->repr;
+    if (!build_repr(list, repr, items, list->size)) {
+        free(items);
+        return false;
+    }
+    free(items);
+
+    switch (old) {
+    case ADAPTIVE_LINKED:
+        clear_list(&list->linked);
+        break;
+    case ADAPTIVE_RING:
+        free(list->ring);
+        list->ring = NULL;
+        list->ring_head = 0;
+        list->ring_capacity = 0;
+        break;
+    case ADAPTIVE_CHUNKED:
+        for (size_t c = 0; c < list->chunk_count; c++) {
+            free(list->chunks[c]);
+        }
+        free(list->chunks);
+        list->chunks = NULL;
+        list->chunk_count = 0;
+        list->chunk_slots = 0;
+        break;
+    default:
+        break;
+    }
+
+    list->repr = repr;
+    list->version++;
+    list->migrations++;
+    list->streak = 0;
+    list->savings = 0;
+    return true;
+}
+
+void adaptive_list_set_adaptive(AdaptiveList* list, bool adaptive) {
+    if (!list) return;
+    list->adaptive = adaptive;
+    memset(list->cost, 0, sizeof(list->cost));
+    list->window_ops = 0;
+    list->streak = 0;
+    list->savings = 0;
+}
+
+// ==================== 插入 / 删除 ====================
+
+bool adaptive_insert_at_head(AdaptiveList* list, void* data) {
+    if (!list) return false;
+    if (!insert_at(list, 0, data)) return false;
+    record(list, OP_HEAD, 0, 0);
+    return true;
+}
+
+bool adaptive_insert_at_tail(AdaptiveList* list, void* data) {
+    if (!list) return false;
+    if (!insert_at(list, list->size, data)) return false;
+    record(list, OP_TAIL, list->size, 0);
+    return true;
+}
+
+bool adaptive_insert_at_position(AdaptiveList* list, void* data, int position) {
+    if (!list) return false;
+    if (position < 0 || (size_t)position > list->size) {
+        fprintf(stderr, "Error: Invalid position %d, size is %zu\n", position, list->size);
+        return false;
+    }
+    if (!insert_at(list, (size_t)position, data)) return false;
+    record(list, OP_EDIT, (size_t)position, 0);
+    return true;
+}
+
+static void drop(AdaptiveList* list, void* data) {
+    if (list->free_data) list->free_data(data);
+}
+
+bool adaptive_delete_at_head(AdaptiveList* list) {
+    if (!list || list->size == 0) return false;
+    drop(list, remove_at(list, 0));
+    record(list, OP_HEAD, 0, 0);
+    return true;
+}
+
+bool adaptive_delete_at_tail(AdaptiveList* list) {
+    if (!list || list->size == 0) return false;
+    drop(list, remove_at(list, list->size - 1));
+    record(list, OP_TAIL, list->size, 0);
+    return true;
+}
+
+bool adaptive_delete_at_position(AdaptiveList* list, int position) {
+    if (!list) return false;
+    if (position < 0 || (size_t)position >= list->size) {
+        fprintf(stderr, "Error: Invalid position %d, size is %zu\n", position, list->size);
+        return false;
+    }
+    drop(list, remove_at(list, (size_t)position));
+    record(list, OP_EDIT, (size_t)position, 0);
+    return true;
+}
+
+// ==================== 查找 / 更新 ====================
+
+typedef struct {
+    AdaptiveList* list;
+    const void* key;
+    void* found;
+} FindCtx;
+
+static bool find_item(void* data, void* ctx) {
+    FindCtx* find = ctx;
+    if (find->list->cmp(data, find->key) != 0) return true;
+    find->found = data;
+    return false;
+}
+
+// 第一个与 key 相等的元素的位置，没有时返回 size
+static size_t find_index(AdaptiveList* list, const void* key, void** found) {
+    FindCtx find = {list, key, NULL};
+    size_t index = visit(list, find_item, &find);
+    *found = find.found;
+    record(list, OP_SCAN, 0, index < list->size ? index + 1 : list->size);
+    return index;
+}
+
+void* adaptive_search_by_value(AdaptiveList* list, void* key) {
+    if (!list || !list->cmp) return NULL;
+    void* found;
+    find_index(list, key, &found);
+    return found;
+}
+
+bool adaptive_delete_by_value(AdaptiveList* list, void* key) {
+    if (!list || !list->cmp) return false;
+    void* found;
+    size_t index = find_index(list, key, &found);
+    if (!found) return false;
+
+    // 迁移只发生在操作之间，查找记录代价后位置仍然有效
+    drop(list, remove_at(list, index));
+    record(list, OP_EDIT, index, 0);
+    return true;
+}
+
+bool adaptive_update_by_value(AdaptiveList* list, const void* key, const void* new_value, update_fn updater) {
+    if (!list || !list->cmp || !updater) return false;
+    void* found;
+    find_index(list, key, &found);
+    if (!found) return false;
+    updater(found, new_value);
+    return true;
+}
+
+void* adaptive_get_at_position(AdaptiveList* list, int position) {
+    if (!list) return NULL;
+    if (position < 0 || (size_t)position >= list->size) {
+        fprintf(stderr, "Error: Invalid position %d, size is %zu\n", position, list->size);
+        return NULL;
+    }
+    void* data = get_at(list, (size_t)position);
+    record(list, OP_GET, (size_t)position, 0);
+    return data;
+}
+
+size_t adaptive_get_length(AdaptiveList* list) {
+    return list ? list->size : 0;
+}
+
+bool adaptive_is_empty(AdaptiveList* list) {
+    return list == NULL || list->size == 0;
+}
+
+typedef struct {
+    void (*fn)(void *data, void *ctx);
+    void* ctx;
+} ForEachCtx;
+
+static bool for_each_item(void* data, void* ctx) {
+    ForEachCtx* each = ctx;
+    each->fn(data, each->ctx);
+    return true;
+}
+
+void adaptive_for_each(AdaptiveList* list, void (*fn)(void *data, void *ctx), void* ctx) {
+    if (!list || !fn) return;
+    ForEachCtx each = {fn, ctx};
+    visit(list, for_each_item, &each);
+    record(list, OP_SCAN, 0, list->size);
+}
+
+// ==================== 游标 ====================
+
+// 链表被绕过游标修改或发生迁移后，按位置重新定位
+static void cursor_sync(AdaptiveCursor* cursor) {
+    AdaptiveList* list = cursor->list;
+    if (cursor->version == list->version) return;
+
+    if (cursor->position > list->size) cursor->position = list->size;
+    bool at_end = cursor->position == list->size;
+    switch (list->repr) {
+    case ADAPTIVE_LINKED:
+        cursor->node = at_end ? NULL : linked_node_at(list, cursor->position);
+        break;
+    case ADAPTIVE_CHUNKED:
+        if (at_end) {
+            cursor->chunk = list->chunk_count;
+            cursor->offset = 0;
+        } else {
+            chunk_locate(list, cursor->position, &cursor->chunk, &cursor->offset);
+        }
+        break;
+    default:
+        break;
+    }
+    cursor->version = list->version;
+}
+
+AdaptiveCursor adaptive_cursor(AdaptiveList* list) {
+    AdaptiveCursor cursor = {list, 0, 0, NULL, 0, 0};
+    if (list) {
+        cursor.version = list->version - 1;
+        cursor_sync(&cursor);
+    }
+    return cursor;
+}
+
+void* adaptive_cursor_get(AdaptiveCursor* cursor) {
+    if (!cursor || !cursor->list) return NULL;
+    cursor_sync(cursor);
+
+    AdaptiveList* list = cursor->list;
+    if (cursor->position >= list->size) return NULL;
+    switch (list->repr) {
+    case ADAPTIVE_LINKED:
+        return cursor->node->data;
+    case ADAPTIVE_RING:
+        return *ring_slot(list, cursor->position);
+    case ADAPTIVE_CHUNKED:
+        return list->chunks[cursor->chunk]->items[cursor->offset];
+    default:
+        return NULL;
+    }
+}
+
+bool adaptive_cursor_next(AdaptiveCursor* cursor) {
+    if (!cursor || !cursor->list) return false;
+    cursor_sync(cursor);
+
+    AdaptiveList* list = cursor->list;
+    if (cursor->position >= list->size) return false;
+    cursor->position++;
+    switch (list->repr) {
+    case ADAPTIVE_LINKED:
+        cursor->node = get_next_node(&list->linked, cursor->node);
+        break;
+    case ADAPTIVE_CHUNKED:
+        if (++cursor->offset == list->chunks[cursor->chunk]->count) {
+            cursor->chunk++;
+            cursor->offset = 0;
+        }
+        break;
+    default:
+        break;
+    }
+    record(list, OP_STEP, cursor->position, 0);
+    return cursor->position < list->size;
+}
+
+bool adaptive_cursor_insert(AdaptiveCursor* cursor, void* data) {
+    if (!cursor || !cursor->list) return false;
+    cursor_sync(cursor);
+
+    AdaptiveList* list = cursor->list;
+    bool ok = false;
+    switch (list->repr) {
+    case ADAPTIVE_LINKED:
+        ok = (cursor->node ? insert_before_node(&list->linked, cursor->node, data)
+                           : insert_at_tail(&list->linked, data)) != NULL;
+        break;
+    case ADAPTIVE_RING:
+        ok = ring_insert(list, cursor->position, data);
+        break;
+    case ADAPTIVE_CHUNKED: {
+        // 末尾插入到最后一块的末尾
+        size_t chunk = cursor->chunk;
+        size_t offset = cursor->offset;
+        if (chunk == list->chunk_count && chunk > 0) {
+            chunk--;
+            offset = list->chunks[chunk]->count;
+        }
+        ok = chunked_insert_at(list, chunk, offset, data, &chunk, &offset);
+        if (ok) {
+            // 游标移到新元素之后
+            if (++offset == list->chunks[chunk]->count) {
+                chunk++;
+                offset = 0;
+            }
+            cursor->chunk = chunk;
+            cursor->offset = offset;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    if (!ok) return false;
+
+    list->size++;
+    list->version++;
+    cursor->position++;
+    cursor->version = list->version;
+    record(list, OP_CURSOR_EDIT, cursor->position, 0);
+    return true;
+}
+
+bool adaptive_cursor_remove(AdaptiveCursor* cursor) {
+    if (!cursor || !cursor->list) return false;
+    cursor_sync(cursor);
+
+    AdaptiveList* list = cursor->list;
+    if (cursor->position >= list->size) return false;
+
+    void* data = NULL;
+    switch (list->repr) {
+    case ADAPTIVE_LINKED: {
+        ListNode* next = get_next_node(&list->linked, cursor->node);
+        data = linked_remove(list, cursor->node);
+        cursor->node = next;
+        break;
+    }
+    case ADAPTIVE_RING:
+        data = ring_remove(list, cursor->position);
+        break;
+    case ADAPTIVE_CHUNKED: {
+        bool dropped;
+        data = chunked_remove_at(list, cursor->chunk, cursor->offset, &dropped);
+        // 整块释放后后一块移到当前下标；否则当前块删空到末尾时进入下一块
+        if (dropped) {
+            cursor->offset = 0;
+        } else if (cursor->offset == list->chunks[cursor->chunk]->count) {
+            cursor->chunk++;
+            cursor->offset = 0;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+
+    list->size--;
+    list->version++;
+    cursor->version = list->version;
+    drop(list, data);
+    record(list, OP_CURSOR_EDIT, cursor->position, 0);
+    return true;
+}
@@ -0,0 +1,311 @@
+#include <stdlib.h>
+#include <string.h>
+#include "id_list.h"
+
+#define ID_DELTAS (ID_BLOCK_COUNT - 1)
+
+// ==================== 位打包 ====================
+
+static uint8_t bit_width(uint64_t value) {
+    return value ? (uint8_t)(64 - __builtin_clzll(value)) : 0;
+}
+
+static uint64_t width_mask(uint8_t width) {
+    return width == 64 ? ~0ULL : (1ULL << width) - 1;
+}
+
+static size_t words_for(size_t deltas, uint8_t width) {
+    return (deltas * width + 63) / 64;
+}
+
+// 写入第 index 个差值；目标位须为 0
+static void put_delta(uint64_t* bits, uint8_t width, size_t index, uint64_t delta) {
+    size_t bit = index * width;
+    size_t word = bit / 64;
+    unsigned shift = bit % 64;
+    bits[word] |= delta << shift;
+    if (shift + width > 64) {
+        bits[word + 1] |= delta >> (64 - shift);
+    }
+}
+
+// 解码整块：先按位宽解出全部差值，再前缀求和。
+// 位宽整除 64 时每个字内的差值位置固定，内层循环无分支、无跨字读取，编译器可向量化
+static void decode_block(const IdBlock* block, int64_t* out) {
+    uint64_t deltas[ID_DELTAS];
+    size_t n = block->count - 1;
+    uint8_t width = block->width;
+    uint64_t mask = width_mask(width);
+
+    if (n > 0 && 64 % width == 0) {
+        size_t per_word = 64 / width;
+        size_t i = 0;
+        for (size_t w = 0; i < n; w++) {
+            uint64_t word = block->bits[w];
+            size_t end = n - i < per_word ? n - i : per_word;
+            for (size_t k = 0; k < end; k++) {
+                deltas[i + k] = (word >> (k * width)) & mask;
+            }
+            i += end;
+        }
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            size_t bit = i * width;
+            size_t word = bit / 64;
+            unsigned shift = bit % 64;
+            uint64_t value = block->bits[word] >> shift;
+            if (shift + width > 64) value |= block->bits[word + 1] << (64 - shift);
+            deltas[i] = value & mask;
+        }
+    }
+
+    // 差值按无符号相加，跨越 0 的 ID 同样正确
+    uint64_t current = (uint64_t)block->first;
+    out[0] = block->first;
+    for (size_t i = 0; i < n; i++) {
+        current += deltas[i];
+        out[i + 1] = (int64_t)current;
+    }
+}
+
+// 用递增的 values 重写块；是最后一块时按满块预留容量，便于继续追加
+static bool encode_block(IdBlock* block, const int64_t* values, size_t count, bool last) {
+    uint64_t max_delta = 0;
+    for (size_t i = 1; i < count; i++) {
+        uint64_t delta = (uint64_t)values[i] - (uint64_t)values[i - 1];
+        if (delta > max_delta) max_delta = delta;
+    }
+    uint8_t width = bit_width(max_delta);
+    size_t words = words_for(last ? ID_DELTAS : count - 1, width);
+
+    uint64_t* bits = NULL;
+    if (words > 0) {
+        bits = calloc(words, sizeof(uint64_t));
+        if (!bits) return false;
+        for (size_t i = 1; i < count; i++) {
+            put_delta(bits, width, i - 1, (uint64_t)values[i] - (uint64_t)values[i - 1]);
+        }
+    }
+
+    free(block->bits);
+    block->bits = bits;
+    block->words = (uint16_t)words;
+    block->width = width;
+    block->count = (uint32_t)count;
+    block->first = values[0];
+    block->last = values[count - 1];
+    return true;
+}
+
+// ==================== 块头数组 ====================
+
+static bool blocks_reserve(IdList* list) {
+    if (list->block_count < list->block_slots) return true;
+
+    size_t slots = list->block_slots ? list->block_slots * 2 : 16;
+    IdBlock* blocks = realloc(list->blocks, slots * sizeof(IdBlock));
+    if (!blocks) return false;
+    list->blocks = blocks;
+    list->block_slots = slots;
+    return true;
+}
+
+static void blocks_remove(IdList* list, size_t index) {
+    free(list->blocks[index].bits);
+    memmove(list->blocks + index, list->blocks + index + 1, (list->block_count - index - 1) * sizeof(IdBlock));
+    list->block_count--;
+}
+
+// 第一个 last >= id 的块，没有时返回 block_count
+static size_t find_block(IdList* list, int64_t id) {
+    size_t low = 0;
+    size_t high = list->block_count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (list->blocks[mid].last < id) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// 块内 id 的下标，不存在时返回 -1
+static int find_in_block(const IdBlock* block, int64_t id, int64_t* values) {
+    decode_block(block, values);
+    size_t low = 0;
+    size_t high = block->count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (values[mid] < id) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low < block->count && values[low] == id ? (int)low : -1;
+}
+
+// ==================== 创建 / 销毁 ====================
+
+IdList* id_list_create(void) {
+    return calloc(1, sizeof(IdList));
+}
+
+void id_list_destroy(IdList* list) {
+    if (!list) return;
+    for (size_t i = 0; i < list->block_count; i++) {
+        free(list->blocks[i].bits);
+    }
+    free(list->blocks);
+    free(list);
+}
+
+// ==================== 追加 / 查找 / 删除 ====================
+
+bool id_list_append(IdList* list, int64_t id) {
+    if (!list) return false;
+
+    IdBlock* block = list->block_count ? &list->blocks[list->block_count - 1] : NULL;
+    if (block && id <= block->last) return false;
+
+    // 最后一块已满时开新块
+    if (!block || block->count == ID_BLOCK_COUNT) {
+        if (!blocks_reserve(list)) return false;
+        block = &list->blocks[list->block_count++];
+        block->first = id;
+        block->last = id;
+        block->bits = NULL;
+        block->count = 1;
+        block->words = 0;
+        block->width = 0;
+        list->size++;
+        return true;
+    }
+
+    // 差值超出当前位宽时按新位宽重写整块
+    uint64_t delta = (uint64_t)id - (uint64_t)block->last;
+    if (bit_width(delta) > block->width) {
+        int64_t values[ID_BLOCK_COUNT];
+        decode_block(block, values);
+        values[block->count] = id;
+        if (!encode_block(block, values, block->count + 1, true)) return false;
+        list->size++;
+        return true;
+    }
+
+    if (block->words < words_for(block->count, block->width)) {
+        size_t words = words_for(ID_DELTAS, block->width);
+        uint64_t* bits = realloc(block->bits, words * sizeof(uint64_t));
+        if (!bits) return false;
+        memset(bits + block->words, 0, (words - block->words) * sizeof(uint64_t));
+        block->bits = bits;
+        block->words = (uint16_t)words;
+    }
+    put_delta(block->bits, block->width, block->count - 1, delta);
+    block->count++;
+    block->last = id;
+    list->size++;
+    return true;
+}
+
+bool id_list_contains(IdList* list, int64_t id) {
+    if (!list) return false;
+
+    size_t index = find_block(list, id);
+    if (index == list->block_count) return false;
+    const IdBlock* block = &list->blocks[index];
+    if (id < block->first) return false;
+    if (id == block->first || id == block->last) return true;
+
+    int64_t values[ID_BLOCK_COUNT];
+    return find_in_block(block, id, values) >= 0;
+}
+
+bool id_list_delete(IdList* list, int64_t id) {
+    if (!list) return false;
+
+    size_t index = find_block(list, id);
+    if (index == list->block_count || id < list->blocks[index].first) return false;
+
+    IdBlock* block = &list->blocks[index];
+    int64_t values[2 * ID_BLOCK_COUNT];
+    int position = find_in_block(block, id, values);
+    if (position < 0) return false;
+
+    size_t count = block->count - 1;
+    if (count == 0) {
+        blocks_remove(list, index);
+        list->size--;
+        return true;
+    }
+    memmove(values + position, values + position + 1, (count - position) * sizeof(int64_t));
+
+    // 块过小且能装进后一块时合并，避免大量删除后只剩很多稀疏的小块
+    bool merge = count < ID_BLOCK_COUNT / 4 && index + 1 < list->block_count &&
+                 count + list->blocks[index + 1].count <= ID_BLOCK_COUNT;
+    if (merge) {
+        decode_block(&list->blocks[index + 1], values + count);
+        count += list->blocks[index + 1].count;
+    }
+
+    bool last = index + 1 + merge == list->block_count;
+    if (!encode_block(block, values, count, last)) return false;
+    if (merge) blocks_remove(list, index + 1);
+    list->size--;
+    return true;
+}
+
+size_t id_list_size(IdList* list) {
+    return list ? list->size : 0;
+}
+
+size_t id_list_memory(IdList* list) {
+    if (!list) return 0;
+
+    size_t bytes = sizeof(IdList) + list->block_slots * sizeof(IdBlock);
+    for (size_t i = 0; i < list->block_count; i++) {
+        bytes += list->blocks[i].words * sizeof(uint64_t);
+    }
+    return bytes;
+}
+
+// ==================== 遍历 ====================
+
+IdIterator id_list_begin(IdList* list) {
+    IdIterator it;
+    it.list = list;
+    it.block = 0;
+    it.index = 0;
+    it.count = 0;
+    return it;
+}
+
+bool id_list_next(IdIterator* it, int64_t* id) {
+    if (!it || !it->list) return false;
+
+    if (it->index == it->count) {
+        if (it->block == it->list->block_count) return false;
+        const IdBlock* block = &it->list->blocks[it->block++];
+        decode_block(block, it->buffer);
+        it->count = block->count;
+        it->index = 0;
+    }
+    *id = it->buffer[it->index++];
+    return true;
+}
+
+size_t id_list_for_each(IdList* list, void (*fn)(int64_t id, void *ctx), void* ctx) {
+    if (!list || !fn) return 0;
+
+    int64_t values[ID_BLOCK_COUNT];
+    for (size_t b = 0; b < list->block_count; b++) {
+        const IdBlock* block = &list->blocks[b];
+        decode_block(block, values);
+        for (size_t i = 0; i < block->count; i++) {
+            fn(values[i], ctx);
+        }
+    }
+    return list->size;
+}
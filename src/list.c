@@ -1,4 +1,25 @@
+#include <string.h>
 #include "list.h"
+#include "list_journal.h"
+
+// 编译时加 -DLIST_TRACE 记录每个公共操作，见 list_trace.h
+#ifdef LIST_TRACE
+#include "list_trace.h"
+#define TRACE_OP(op, list, position, key) list_trace_record((op), (list), (position), (key))
+#else
+#define TRACE_OP(op, list, position, key) ((void)0)
+#endif
+
+// 墓碑标记存放在 block 指针的最低位（NodeBlock 由 malloc 分配，最低位恒为 0），不增加节点大小
+#define NODE_TOMBSTONE ((uintptr_t)1)
+
+static NodeBlock* node_block(const ListNode* node) {
+    return (NodeBlock *)((uintptr_t)node->block & ~NODE_TOMBSTONE);
+}
+
+bool is_tombstone(const ListNode* node) {
+    return node && ((uintptr_t)node->block & NODE_TOMBSTONE);
+}
 
 ListNode* create_node(void* data) {
     ListNode* node = malloc(sizeof(ListNode));
@@ -7,81 +28,492 @@ ListNode* create_node(void* data) {
     node->data = data;
     node->prev = NULL;
     node->next = NULL;
+    node->block = NULL;
 
     return node;
 }
 
-List* init_list(int (*cmp)(const void *, const void *), void (*free_data)(void *)) {
-    List *list = malloc(sizeof(List));
-    if (!list) return NULL;
+void free_node(ListNode* node) {
+    if (!node) return;
+
+    // 批量分配的节点：块内全部节点都释放后才归还整块内存
+    NodeBlock* block = node_block(node);
+    if (block) {
+        if (--block->live == 0) {
+            free(block);
+        }
+        return;
+    }
+    free(node);
+}
+
+// 数据是否由 compact_list 嵌入在节点旁（随节点块释放）
+static bool data_embedded(ListNode* node) {
+    NodeBlock* block = node_block(node);
+    return block && block->payload_size > 0 &&
+           node->data == (char *)node + sizeof(ListNode);
+}
+
+// 释放节点及其数据；free_data 为空表示链表不持有数据，嵌入节点块的数据随块释放
+static void release_node(List* list, ListNode* node) {
+    if (list->free_data && !data_embedded(node)) {
+        list->free_data(node->data);
+    }
+    free_node(node);
+}
+
+// ==================== 指纹 ====================
+// 指纹 = 序列 [哨兵, x1, ..., xn, 哨兵] 中所有相邻对 pair(h(xi), h(xi+1)) 之和（模 2^64）
+// 相邻对而非绝对位置使中间插入 / 删除只影响常数个项；正反两个方向各维护一份，反转时交换即可
+
+#define FP_SENTINEL 0x243f6a8885a308d3ULL
+
+static uint64_t fp_mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+static uint64_t fp_pair(uint64_t a, uint64_t b) {
+    return fp_mix(a ^ fp_mix(b + 0x9e3779b97f4a7c15ULL));
+}
+
+static uint64_t fp_hash(List* list, ListNode* node) {
+    return node ? list->hash(node->data) : FP_SENTINEL;
+}
+
+static void fp_adjust(List* list, uint64_t a, uint64_t b, bool add) {
+    if (add) {
+        list->fp_forward += fp_pair(a, b);
+        list->fp_backward += fp_pair(b, a);
+    } else {
+        list->fp_forward -= fp_pair(a, b);
+        list->fp_backward -= fp_pair(b, a);
+    }
+}
+
+// 连续节点段 [first, last] 挂入（add）或即将摘除（!add）时修正指纹，段两端的邻居必须已就位
+static void fp_run(List* list, ListNode* first, ListNode* last, bool add) {
+    uint64_t before = fp_hash(list, first->prev);
+    uint64_t after = fp_hash(list, last->next);
+
+    fp_adjust(list, before, after, !add);
+    uint64_t prev = before;
+    for (ListNode* node = first; ; node = node->next) {
+        uint64_t current = list->hash(node->data);
+        fp_adjust(list, prev, current, add);
+        prev = current;
+        if (node == last) break;
+    }
+    fp_adjust(list, prev, after, add);
+}
+
+// ==================== 过滤器 ====================
+// 每个元素占用 FILTER_COUNTERS_PER_ITEM 个计数器、FILTER_HASHES 个位置（误判率约 2%）
+// 位置由一个 64 位哈希经双重哈希派生；元素数超过容量时容量翻倍并按链表内容重建
+
+#define FILTER_HASHES 4
+#define FILTER_COUNTERS_PER_ITEM 8
+#define FILTER_MIN_CAPACITY 64
+
+static size_t filter_index(ListFilter* filter, uint64_t hash, int i) {
+    uint64_t h1 = fp_mix(hash);
+    uint64_t h2 = fp_mix(hash ^ 0x9e3779b97f4a7c15ULL) | 1;
+    return (size_t)(h1 + (uint64_t)i * h2) & filter->mask;
+}
+
+static void filter_add(ListFilter* filter, uint64_t hash) {
+    for (int i = 0; i < FILTER_HASHES; i++) {
+        uint8_t* counter = &filter->counters[filter_index(filter, hash, i)];
+        if (*counter < UINT8_MAX) (*counter)++;
+    }
+}
+
+static void filter_remove(ListFilter* filter, uint64_t hash) {
+    for (int i = 0; i < FILTER_HASHES; i++) {
+        uint8_t* counter = &filter->counters[filter_index(filter, hash, i)];
+        // 饱和的计数器已无法得知真实计数，保持不变
+        if (*counter > 0 && *counter < UINT8_MAX) (*counter)--;
+    }
+}
+
+static bool filter_test(ListFilter* filter, uint64_t hash) {
+    for (int i = 0; i < FILTER_HASHES; i++) {
+        if (filter->counters[filter_index(filter, hash, i)] == 0) return false;
+    }
+    return true;
+}
+
+// 按至少 capacity 个元素重新分配计数器并加入链表中所有元素；分配失败时保留原过滤器
+static bool filter_rebuild(List* list, size_t capacity) {
+    ListFilter* filter = list->filter;
+
+    size_t count = FILTER_MIN_CAPACITY * FILTER_COUNTERS_PER_ITEM;
+    while (count < capacity * FILTER_COUNTERS_PER_ITEM) {
+        count *= 2;
+    }
+
+    uint8_t* counters = calloc(count, sizeof(uint8_t));
+    if (!counters) return false;
+
+    free(filter->counters);
+    filter->counters = counters;
+    filter->mask = count - 1;
+    filter->capacity = count / FILTER_COUNTERS_PER_ITEM;
+
+    for (ListNode* node = list->head; node; node = node->next) {
+        filter_add(filter, list->hash(node->data));
+    }
+    return true;
+}
+
+// ==================== 链接钩子 ====================
+// 所有改变链表成员或原地修改数据的操作都经过以下钩子，附加在链表上的增量结构在此维护
+
+// 节点段 [first, last] 已挂入链表
+static void track_linked(List* list, ListNode* first, ListNode* last) {
+    if (list->fingerprint) fp_run(list, first, last, true);
+
+    if (list->filter) {
+        // 超出容量时整体重建（已包含新挂入的段），均摊 O(1)
+        size_t capacity = list->filter->capacity * 2;
+        if (list->size > list->filter->capacity &&
+            filter_rebuild(list, capacity > list->size ? capacity : list->size)) {
+            return;
+        }
+        for (ListNode* node = first; ; node = node->next) {
+            filter_add(list->filter, list->hash(node->data));
+            if (node == last) break;
+        }
+    }
+}
+
+// 节点段 [first, last] 的数据即将离开链表：从指纹与过滤器中撤销
+static void untrack_data(List* list, ListNode* first, ListNode* last) {
+    if (list->fingerprint) fp_run(list, first, last, false);
+
+    if (list->filter) {
+        for (ListNode* node = first; ; node = node->next) {
+            filter_remove(list->filter, list->hash(node->data));
+            if (node == last) break;
+        }
+    }
+}
+
+// 节点段 [first, last] 即将从链表摘除
+static void track_unlinking(List* list, ListNode* first, ListNode* last) {
+    // 增量压缩的游标即将被摘除：移到段之后
+    if (list->compact_cursor) {
+        for (ListNode* node = first; ; node = node->next) {
+            if (node == list->compact_cursor) {
+                list->compact_cursor = last->next;
+                break;
+            }
+            if (node == last) break;
+        }
+    }
+
+    untrack_data(list, first, last);
+}
+
+// 节点的数据即将原地修改，修改后调用 track_linked；节点留在链表中，增量压缩的游标不动
+static void track_updating(List* list, ListNode* node) {
+    untrack_data(list, node, node);
+}
+
+// 在 prev 与 next 之间挂入节点（prev / next 为 NULL 表示头 / 尾）
+static void link_node(List* list, ListNode* prev, ListNode* node, ListNode* next) {
+    node->prev = prev;
+    node->next = next;
+
+    if (prev) {
+        prev->next = node;
+    } else {
+        list->head = node;
+    }
+
+    if (next) {
+        next->prev = node;
+    } else {
+        list->tail = node;
+    }
+
+    list->size++;
+    track_linked(list, node, node);
+}
+
+static void unlink_node(List* list, ListNode* node) {
+    track_unlinking(list, node, node);
+
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        list->head = node->next;
+    }
+
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        list->tail = node->prev;
+    }
+
+    list->size--;
+}
+
+// 在 prev 与 next 之间挂入 count 个节点组成的段 [first, last]
+static void link_run(List* list, ListNode* prev, ListNode* first, ListNode* last, ListNode* next, size_t count) {
+    first->prev = prev;
+    last->next = next;
+
+    if (prev) {
+        prev->next = first;
+    } else {
+        list->head = first;
+    }
+
+    if (next) {
+        next->prev = last;
+    } else {
+        list->tail = last;
+    }
+
+    list->size += count;
+    track_linked(list, first, last);
+}
+
+// 摘下 count 个节点组成的段 [first, last]，段内链接保持不变
+static void unlink_run(List* list, ListNode* first, ListNode* last, size_t count) {
+    track_unlinking(list, first, last);
+
+    if (first->prev) {
+        first->prev->next = last->next;
+    } else {
+        list->head = last->next;
+    }
+
+    if (last->next) {
+        last->next->prev = first->prev;
+    } else {
+        list->tail = first->prev;
+    }
+
+    list->size -= count;
+}
+
+// 链表已不再持有任何节点时重置为空
+static void reset_links(List* list) {
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+    list->tombstones = 0;
+    list->reversed = false;
+    list->compact_cursor = NULL;
+    if (list->fingerprint) {
+        list->fp_forward = fp_pair(FP_SENTINEL, FP_SENTINEL);
+        list->fp_backward = list->fp_forward;
+    }
+    if (list->filter) {
+        memset(list->filter->counters, 0, list->filter->mask + 1);
+    }
+}
+
+// ==================== 逻辑方向 ====================
+// reversed 时逻辑头为 tail、逻辑后继为 prev；内部按逻辑顺序操作时统一经过以下函数
 
+static ListNode* first_of(List* list) {
+    return list->reversed ? list->tail : list->head;
+}
+
+static ListNode* last_of(List* list) {
+    return list->reversed ? list->head : list->tail;
+}
+
+static ListNode* next_of(List* list, ListNode* node) {
+    return list->reversed ? node->prev : node->next;
+}
+
+static ListNode* prev_of(List* list, ListNode* node) {
+    return list->reversed ? node->next : node->prev;
+}
+
+// 按逻辑顺序把节点挂在 prev 与 next 之间
+static void link_logical(List* list, ListNode* prev, ListNode* node, ListNode* next) {
+    if (list->reversed) {
+        link_node(list, next, node, prev);
+    } else {
+        link_node(list, prev, node, next);
+    }
+}
+
+// 交换每个节点的 prev / next 并翻转方向标志，逻辑顺序不变
+static void flip_links(List* list) {
+    ListNode* current = list->head;
+    while (current) {
+        ListNode* next = current->next;
+        current->next = current->prev;
+        current->prev = next;
+        current = next;
+    }
+
+    ListNode* head = list->head;
+    list->head = list->tail;
+    list->tail = head;
+    list->reversed = !list->reversed;
+    if (list->compact_cursor) list->compact_cursor = list->head;
+
+    // 正反方向互换，指纹无需重算
+    uint64_t forward = list->fp_forward;
+    list->fp_forward = list->fp_backward;
+    list->fp_backward = forward;
+}
+
+// ==================== 延迟删除 ====================
+// 墓碑节点仍留在链表中（持有它的句柄和迭代器继续有效），size 含墓碑，遍历、查找、按位置访问跳过它们
+
+static size_t live_size(List* list) {
+    return list->size - list->tombstones;
+}
+
+// 从 node 起沿逻辑方向（forward 为 false 时反向）跳过墓碑
+static ListNode* skip_dead(List* list, ListNode* node, bool forward) {
+    while (node && is_tombstone(node)) {
+        node = forward ? next_of(list, node) : prev_of(list, node);
+    }
+    return node;
+}
+
+static ListNode* first_live(List* list) {
+    return skip_dead(list, first_of(list), true);
+}
+
+static ListNode* last_live(List* list) {
+    return skip_dead(list, last_of(list), false);
+}
+
+static ListNode* next_live(List* list, ListNode* node) {
+    return skip_dead(list, next_of(list, node), true);
+}
+
+static ListNode* prev_live(List* list, ListNode* node) {
+    return skip_dead(list, prev_of(list, node), false);
+}
+
+// 删除节点：延迟删除模式下只标记为墓碑，否则立即摘链释放
+static size_t purge_except(List* list, ListNode* keep);
+
+static void remove_node(List* list, ListNode* node) {
+    if (!list->deferred_delete) {
+        unlink_node(list, node);
+        release_node(list, node);
+        return;
+    }
+
+    node->block = (NodeBlock *)((uintptr_t)node->block | NODE_TOMBSTONE);
+    list->tombstones++;
+    // 自动清理保留刚删除的节点，调用方仍可从它前进；更早的墓碑被释放
+    if (list->purge_ratio > 0 && list->tombstones > list->purge_ratio * list->size) {
+        purge_except(list, node);
+    }
+}
+
+// ==================== 日志 ====================
+// 启用预写日志时记录每次修改，见 list_journal.h
+
+// 节点的逻辑位置，O(n)；只在启用日志时供以节点为参数的操作使用
+static int node_position(List* list, ListNode* node) {
+    int position = 0;
+    for (ListNode* current = prev_live(list, node); current; current = prev_live(list, current)) {
+        position++;
+    }
+    return position;
+}
+
+// 记录从 first 起按逻辑顺序新挂入的 count 个节点
+static void journal_inserted(List* list, ListNode* first, size_t count, int position) {
+    ListNode* node = first;
+    for (size_t i = 0; i < count; i++, node = next_live(list, node)) {
+        list_journal_record(list, JOURNAL_INSERT, position + (int)i, NULL, node->data);
+    }
+}
+
+void init_list_inplace(List* list, int (*cmp)(const void *, const void *), void (*free_data)(void *)) {
     list->head = NULL;
     list->tail = NULL;
     list->size = 0;
+    list->reversed = false;
     list->cmp = cmp;
     list->free_data = free_data;
+    list->hash = NULL;
+    list->batch_cmp = NULL;
+    list->fingerprint = false;
+    list->fp_forward = 0;
+    list->fp_backward = 0;
+    list->filter = NULL;
+    list->compact_cursor = NULL;
+    list->journal = NULL;
+    list->deferred_delete = false;
+    list->tombstones = 0;
+    list->purge_ratio = 0;
+}
+
+List* init_list(int (*cmp)(const void *, const void *), void (*free_data)(void *)) {
+    List *list = malloc(sizeof(List));
+    if (!list) return NULL;
+
+    init_list_inplace(list, cmp, free_data);
 
     return list;
 }
 
 bool is_empty(List* list) {
-    return list == NULL ? true : (list->size == 0);
+    return list == NULL ? true : (live_size(list) == 0);
 }
 
 size_t get_length(List* list) {
     if (!list) return 0;
-    return list->size;
+    return live_size(list);
 }
 
 ListNode* insert_at_tail(List* list, void* data) {
     if (!list) return NULL;
+    TRACE_OP(TRACE_INSERT_TAIL, list, -1, data);
 
     ListNode* new_node = create_node(data);
     if (!new_node) {
         return NULL;
     }
 
-    if (list->tail == NULL) {
-        list->head = new_node;
-        list->tail = new_node;
-    } else {
-        new_node->prev = list->tail;    // 新节点的前驱指针，要指向原来的尾节点
-        list->tail->next = new_node;    // 原尾节点的后继指针，原本指向 NULL ，要将它指向新节点
-        list->tail = new_node;          // 尾指针，指向新节点
-        
-    }
+    // 新节点挂在原尾节点之后，尾指针指向新节点
+    link_logical(list, last_of(list), new_node, NULL);
+    if (list->journal) list_journal_record(list, JOURNAL_INSERT, (int)live_size(list) - 1, NULL, data);
 
-    list->size++;
     return new_node;
 }
 
 ListNode* insert_at_head(List* list, void* data) {
     if (!list) return NULL;
+    TRACE_OP(TRACE_INSERT_HEAD, list, -1, data);
 
     ListNode* new_node = create_node(data);
     if (!new_node) {
         return NULL;
     }
 
-    if (list->head == NULL) {
-        list->head = new_node;
-        list->tail = new_node;
-    } else {
-        new_node->next = list->head;
-        list->head->prev = new_node;
-        list->head = new_node;
-    }
+    link_logical(list, NULL, new_node, first_of(list));
+    if (list->journal) list_journal_record(list, JOURNAL_INSERT, 0, NULL, data);
 
-    list->size++;
     return new_node;
 }
 
 ListNode* insert_at_position(List* list, void* data, int position) {
     if (!list) return NULL;
 
-    if (position < 0 || position > list->size) {
+    if (position < 0 || position > live_size(list)) {
         fprintf(stderr, "Error: Invalid position %d, size is %d\n", 
-                position, list->size);
+                position, live_size(list));
         return NULL;
     }
 
@@ -91,82 +523,164 @@ ListNode* insert_at_position(List* list, void* data, int position) {
     }
 
     // 特殊情况：插入到尾部
-    if (position == list->size) {
+    if (position == live_size(list)) {
         return insert_at_tail(list, data);
     }
 
+    TRACE_OP(TRACE_INSERT_POSITION, list, position, data);
+
     ListNode* new_node = create_node(data);
     if (!new_node) {
         return NULL;
     }
-    ListNode* current = list->head;
+    ListNode* current = first_live(list);
     for (int i = 0; i < position - 1 && current; i++) {
-        current = current->next;
+        current = next_live(list, current);
     }
     if (!current) {
-        list->free_data(new_node->data);
-        free(new_node);
+        if (list->free_data) list->free_data(new_node->data);
+        free_node(new_node);
         return NULL;
     }
 
     // 在current之后插入新节点
-    new_node->prev = current;
-    new_node->next = current->next;
-
-    if (current->next) {
-        current->next->prev = new_node;
-    }
-    current->next = new_node;
-    list->size++;
+    link_logical(list, current, new_node, next_of(list, current));
+    if (list->journal) list_journal_record(list, JOURNAL_INSERT, position, NULL, data);
 
     return new_node;
 }
 
 ListNode* insert_after_node(List* list, ListNode* target, void* data) {
     if (!list || !target) return NULL;
+    TRACE_OP(TRACE_INSERT_AFTER, list, -1, data);
 
     ListNode* new_node = create_node(data);
     if (!new_node) return NULL;
 
-    new_node->prev = target;
-    new_node->next = target->next;
-
-    if (target->next) {
-        target->next->prev = new_node;
-    } else {
-        list->tail = new_node;
-    }
-    target->next = new_node;
+    link_logical(list, target, new_node, next_of(list, target));
+    if (list->journal) list_journal_record(list, JOURNAL_INSERT, node_position(list, new_node), NULL, data);
 
-    list->size++;
-    return new_node; 
+    return new_node;
 }
 
 ListNode* insert_before_node(List* list, ListNode* target, void* data) {
     if (!list || !target) return NULL;
+    TRACE_OP(TRACE_INSERT_BEFORE, list, -1, data);
 
     ListNode* new_node = create_node(data);
     if (!new_node) return NULL;
 
-    new_node->next = target;
-    new_node->prev = target->prev;
+    link_logical(list, prev_of(list, target), new_node, target);
+    if (list->journal) list_journal_record(list, JOURNAL_INSERT, node_position(list, new_node), NULL, data);
 
-    if (target->prev) {
-        target->prev->next = new_node;
-    } else {
-        list->head = new_node;
+    return new_node;
+}
+
+// 摘链 / 挂链的内部实现，供 move_to_head / move_to_tail 共用（不记录跟踪）
+static ListNode* detach(List* list, ListNode* node) {
+    // 墓碑已按删除记录过，摘下时只需扣除计数
+    if (is_tombstone(node)) {
+        node->block = node_block(node);
+        list->tombstones--;
+    } else if (list->journal) {
+        list_journal_record(list, JOURNAL_DELETE, node_position(list, node), NULL, NULL);
     }
+    unlink_node(list, node);
+    node->prev = NULL;
+    node->next = NULL;
 
-    target->prev = new_node;
-    list->size++;
+    return node;
+}
 
-    return new_node;
+static ListNode* attach_tail(List* list, ListNode* node) {
+    link_logical(list, last_of(list), node, NULL);
+    if (list->journal) list_journal_record(list, JOURNAL_INSERT, (int)live_size(list) - 1, NULL, node->data);
+
+    return node;
 }
 
-ListNode* search_by_value(List* list, void* key) {
-    if (!list || !list->cmp) return NULL;
+static ListNode* attach_head(List* list, ListNode* node) {
+    link_logical(list, NULL, node, first_of(list));
+    if (list->journal) list_journal_record(list, JOURNAL_INSERT, 0, NULL, node->data);
+
+    return node;
+}
+
+ListNode* detach_node(List* list, ListNode* node) {
+    if (!list || !node) return NULL;
+    TRACE_OP(TRACE_DETACH_NODE, list, -1, node->data);
+
+    return detach(list, node);
+}
+
+ListNode* attach_node_at_tail(List* list, ListNode* node) {
+    if (!list || !node) return NULL;
+    TRACE_OP(TRACE_ATTACH_TAIL, list, -1, node->data);
+
+    return attach_tail(list, node);
+}
+
+ListNode* attach_node_at_head(List* list, ListNode* node) {
+    if (!list || !node) return NULL;
+    TRACE_OP(TRACE_ATTACH_HEAD, list, -1, node->data);
+
+    return attach_head(list, node);
+}
+
+bool move_to_head(List* list, ListNode* node) {
+    if (!list || !node || is_tombstone(node)) return false;
+    TRACE_OP(TRACE_MOVE_HEAD, list, -1, node->data);
+    if (first_live(list) == node) return true;
+
+    detach(list, node);
+    attach_head(list, node);
+    return true;
+}
+
+bool move_to_tail(List* list, ListNode* node) {
+    if (!list || !node || is_tombstone(node)) return false;
+    TRACE_OP(TRACE_MOVE_TAIL, list, -1, node->data);
+    if (last_live(list) == node) return true;
+
+    detach(list, node);
+    attach_tail(list, node);
+    return true;
+}
+
+// 从 start 起沿逻辑方向（backward 时反向）每次收集 LIST_BATCH_SIZE 个节点的数据交给批量比较
+static ListNode* find_node_batch(List* list, const void* key, ListNode* start, bool backward) {
+    const void* data[LIST_BATCH_SIZE];
+
+    // 物理上沿 next 还是 prev 前进只取决于两个方向标志，提到循环外
+    bool along_next = backward == list->reversed;
+    ListNode* node = start;
+    while (node) {
+        ListNode* batch = node;
+        size_t count = 0;
+        while (node && count < LIST_BATCH_SIZE) {
+            if (!is_tombstone(node)) data[count++] = node->data;
+            node = along_next ? node->next : node->prev;
+        }
+        if (count == 0) break;
+
+        uint64_t mask = list->batch_cmp(key, data, count) & ((1ULL << count) - 1);
+        if (mask) {
+            // 命中时才从本批开头数到匹配的节点，收集时不必另存节点指针
+            int index = __builtin_ctzll(mask);
+            for (;; batch = along_next ? batch->next : batch->prev) {
+                if (!is_tombstone(batch) && index-- == 0) return batch;
+            }
+        }
+    }
+    return NULL;
+}
+
+// 按值查找的内部实现，供查找 / 删除 / 更新共用（不记录跟踪）
+static ListNode* find_node(List* list, const void* key) {
+    if (!filter_may_contain(list, key)) return NULL;
+    if (list->batch_cmp) return find_node_batch(list, key, first_of(list), false);
 
-    for (ListNode *current = list->head; current; current = current->next) {
+    for (ListNode *current = first_live(list); current; current = next_live(list, current)) {
         if (list->cmp(current->data, key) == 0) {
             return current;
         } 
@@ -174,13 +688,24 @@ ListNode* search_by_value(List* list, void* key) {
     return NULL;
 }
 
+ListNode* search_by_value(List* list, void* key) {
+    if (!list || !list->cmp) return NULL;
+    TRACE_OP(TRACE_SEARCH, list, -1, key);
+
+    return find_node(list, key);
+}
+
 ListNode* search_by_value_reverse(List* list, void* key) {
     if (!list) return NULL;
+    TRACE_OP(TRACE_SEARCH_REVERSE, list, -1, key);
+
+    if (!filter_may_contain(list, key)) return NULL;
+    if (list->batch_cmp) return find_node_batch(list, key, last_of(list), true);
 
-    ListNode* current = list->tail;
+    ListNode* current = last_live(list);
     while (current) {
         if (list->cmp(current->data, key) == 0) return current;
-        current = current->prev;
+        current = prev_live(list, current);
     }
     return NULL;
 }
@@ -188,15 +713,16 @@ ListNode* search_by_value_reverse(List* list, void* key) {
 ListNode* get_node_at_position(List* list, int position) {
     if (!list) return NULL;
 
-    if (position < 0 || position > list->size) {
+    if (position < 0 || position > live_size(list)) {
         fprintf(stderr, "Error: Invalid position %d, size is %d\n", 
-                position, list->size);
+                position, live_size(list));
         return NULL;
     }
+    TRACE_OP(TRACE_GET_POSITION, list, position, NULL);
 
-    ListNode* current = list->head;
+    ListNode* current = first_live(list);
     for (int i = 0; i < position && current; i++) {
-        current = current->next;
+        current = next_live(list, current);
     }
 
     if (!current) return NULL;
@@ -207,15 +733,16 @@ ListNode* get_node_at_position(List* list, int position) {
 ListNode* get_node_at_position_reverse(List* list, int position) {
     if (!list) return NULL;
 
-    if (position < 0 || position > list->size) {
+    if (position < 0 || position > live_size(list)) {
         fprintf(stderr, "Error: Invalid position %d, size is %d\n", 
-                position, list->size);
+                position, live_size(list));
         return NULL;
     }
+    TRACE_OP(TRACE_GET_POSITION_REVERSE, list, position, NULL);
 
-    ListNode* current = list->tail;
+    ListNode* current = last_live(list);
     for (int i = 0; i < position && current; i++) {
-        current = current->prev;
+        current = prev_live(list, current);
     }
     if (!current) return NULL;
 
@@ -223,76 +750,53 @@ ListNode* get_node_at_position_reverse(List* list, int position) {
 }
 
 bool delete_at_head(List* list) {
-    if (!list || !list->free_data || !list->head) return false;
+    if (!list || !list->head) return false;
 
     if (is_empty(list)) return false;
 
-    ListNode* node = list->head;
-    if (list->head == list->tail) {
-        list->head = list->tail = NULL;
-    } else {
-        list->head = list->head->next;
-        list->head->prev = NULL;
-    }
+    TRACE_OP(TRACE_DELETE_HEAD, list, -1, NULL);
 
-    list->free_data(node->data);
-    free(node);
-    list->size--;
+    ListNode* node = first_live(list);
+    if (list->journal) list_journal_record(list, JOURNAL_DELETE, 0, NULL, NULL);
+    remove_node(list, node);
 
     return true;
 }
 
 bool delete_at_tail(List* list) {
-    if (!list || !list->free_data || !list->tail) return false;
+    if (!list || !list->tail) return false;
 
     if (is_empty(list)) return false;
 
-    ListNode* node = list->tail;
-    if (list->head == list->tail) {
-        list->head = list->tail = NULL;
-    } else {
-        list->tail = list->tail->prev;
-        list->tail->next = NULL;
-    }
+    TRACE_OP(TRACE_DELETE_TAIL, list, -1, NULL);
 
-    list->free_data(node->data);
-    free(node);
-    list->size--;
+    ListNode* node = last_live(list);
+    if (list->journal) list_journal_record(list, JOURNAL_DELETE, (int)live_size(list) - 1, NULL, NULL);
+    remove_node(list, node);
 
     return true;
 }
 
 bool delete_by_value(List* list, void* key) {
-    if (!list || !list->cmp || !list->free_data) return false;
+    if (!list || !list->cmp) return false;
 
-    ListNode* node = search_by_value(list, key);
-    if (!node) return false;
-
-    if (node->prev) {
-        node->prev->next = node->next;
-    } else {
-        list->head = node->next;
-    }
+    TRACE_OP(TRACE_DELETE_VALUE, list, -1, key);
 
-    if (node->next) {
-        node->next->prev = node->prev;
-    } else {
-        list->tail = node->prev;
-    }
+    ListNode* node = find_node(list, key);
+    if (!node) return false;
 
-    list->free_data(node->data);
-    free(node);
-    list->size--;
+    if (list->journal) list_journal_record(list, JOURNAL_DELETE_KEY, -1, key, NULL);
+    remove_node(list, node);
 
     return true;
 }
 
 bool delete_at_position(List* list, int position) {
-    if (!list || !list->free_data) return false;
+    if (!list) return false;
 
-    if (position < 0 || position >= list->size) {
+    if (position < 0 || position >= live_size(list)) {
         fprintf(stderr, "Error: Invalid position %d, size is %d\n", 
-                position, list->size);
+                position, live_size(list));
         return false;
     }
 
@@ -300,51 +804,39 @@ bool delete_at_position(List* list, int position) {
         return delete_at_head(list);
     }
 
-    if (position == list->size -1) {
+    if (position == live_size(list) - 1) {
         return delete_at_tail(list);
     }
 
-    ListNode* current = list->head;
+    TRACE_OP(TRACE_DELETE_POSITION, list, position, NULL);
+
+    ListNode* current = first_live(list);
     for (int i = 0; i < position && current; i++) {
-        current = current->next;
+        current = next_live(list, current);
     }
     if (!current) return false;
 
-    if (current->prev) {
-        current->prev->next = current->next;
-    }
-    if (current->next) {
-        current->next->prev = current->prev;
-    }
-    
-    list->free_data(current->data);
-    free(current);
-    list->size--;
+    if (list->journal) list_journal_record(list, JOURNAL_DELETE, position, NULL, NULL);
+    remove_node(list, current);
 
     return true;
 }
 
 bool delete_node(List* list, ListNode* node) {
-    if (!list || !node) return false;
+    if (!list || !node || is_tombstone(node)) return false;
 
-    if (list->head == node) {
+    if (first_live(list) == node) {
         return delete_at_head(list);
     }
 
-    if (list->tail == node) {
+    if (last_live(list) == node) {
         return delete_at_tail(list);
     }
 
-    if (node->prev) {
-        node->prev->next = node->next;
-    }
-    if (node->next) {
-        node->next->prev = node->prev;
-    }
+    TRACE_OP(TRACE_DELETE_NODE, list, -1, node->data);
 
-    list->free_data(node->data);
-    free(node);
-    list->size--;
+    if (list->journal) list_journal_record(list, JOURNAL_DELETE, node_position(list, node), NULL, NULL);
+    remove_node(list, node);
 
     return true;
 }
@@ -352,28 +844,63 @@ bool delete_node(List* list, ListNode* node) {
 bool update_by_value(List* list, const void *key, const void *new_value, update_fn updater) {
     if (!list || !updater || !list->cmp) return false;
 
-    ListNode* current = search_by_value(list, key);
+    TRACE_OP(TRACE_UPDATE_VALUE, list, -1, key);
+
+    ListNode* current = find_node(list, key);
     if (!current) return false;
 
+    track_updating(list, current);
     updater(current->data, new_value);
+    track_linked(list, current, current);
+    if (list->journal) list_journal_record(list, JOURNAL_UPDATE_KEY, -1, key, current->data);
 
     return true;
 } 
 
 bool update_node(List* list, ListNode* node, const void* new_value, update_fn updater) {
-    if (!list || !node || !updater) return false;
+    return update_node_at(list, node, -1, new_value, updater);
+}
+
+bool update_node_at(List* list, ListNode* node, int position, const void* new_value, update_fn updater) {
+    if (!list || !node || !updater || is_tombstone(node)) return false;
+    TRACE_OP(TRACE_UPDATE_NODE, list, -1, node->data);
 
+    track_updating(list, node);
     updater(node->data, new_value);
+    track_linked(list, node, node);
+    if (list->journal) {
+        if (position < 0) position = node_position(list, node);
+        list_journal_record(list, JOURNAL_UPDATE, position, NULL, node->data);
+    }
+    return true;
+}
+
+bool replace_node_data(List* list, ListNode* node, void* data) {
+    if (!list || !node || is_tombstone(node)) return false;
+    TRACE_OP(TRACE_REPLACE_NODE, list, -1, data);
+
+    track_updating(list, node);
+    if (list->free_data && !data_embedded(node) && node->data != data) {
+        list->free_data(node->data);
+    }
+    node->data = data;
+    track_linked(list, node, node);
+    if (list->journal) list_journal_record(list, JOURNAL_UPDATE, node_position(list, node), NULL, data);
     return true;
 }
    
 size_t update_if(List* list, predicate_fn pred, const void* new_value, update_fn updater) {
     if (!list || !pred ||!updater) return 0;
+    TRACE_OP(TRACE_UPDATE_IF, list, -1, NULL);
 
     size_t count = 0;
-    for (ListNode* current = list->head; current; current = current->next) {
+    int position = 0;
+    for (ListNode* current = first_live(list); current; current = next_live(list, current), position++) {
         if (pred(current->data)) {
+            track_updating(list, current);
             updater(current->data, new_value);
+            track_linked(list, current, current);
+            if (list->journal) list_journal_record(list, JOURNAL_UPDATE, position, NULL, current->data);
             count++;
         }
     }
@@ -381,24 +908,951 @@ size_t update_if(List* list, predicate_fn pred, const void* new_value, update_fn
 }
 
 void clear_list(List* list) {
-    if (!list || !list->free_data) return;
+    if (!list) return;
+    TRACE_OP(TRACE_CLEAR, list, -1, NULL);
+    if (list->journal && live_size(list) > 0) list_journal_record(list, JOURNAL_CLEAR, -1, NULL, NULL);
 
     ListNode* current = list->head;
     while (current) {
         ListNode* next = current->next;
-        list->free_data(current->data);
-        free(current);
+        release_node(list, current);
         current = next;
     }
 
-    list->head = NULL;
-    list->tail = NULL;
-    list->size = 0;
+    reset_links(list);
 }
- 
+
 void destroy_list(List* list) {
     if (!list) return;
+    // 先关闭日志：销毁不是清空，日志中的内容保留供下次回放
+    list_journal_close(list);
     clear_list(list);
+    disable_filter(list);
     free(list);
 }
 
+
+// 复制的内部实现，供 clone_list 共用（不记录跟踪）
+static bool copy_nodes(List* dest_list, List* src_list, copy_fn copier) {
+    // 深复制出的数据只能由目标链表释放：目标不持有数据时副本无人释放（回滚时也一样），拒绝
+    if (copier && !dest_list->free_data) return false;
+
+    size_t count = live_size(src_list);
+    if (count == 0) return true;
+
+    // 目标节点一次性分配在同一块内存中
+    NodeBlock* block = malloc(sizeof(NodeBlock) + count * sizeof(ListNode));
+    if (!block) return false;
+    block->live = count;
+    block->payload_size = 0;
+
+    // 按源链表的逻辑顺序复制；目标为逆向时块内按相反次序存放，使物理链接与块内地址一致
+    ListNode* nodes = block->nodes;
+    size_t i = 0;
+    for (ListNode* current = first_live(src_list); current; current = next_live(src_list, current), i++) {
+        ListNode* node = &nodes[dest_list->reversed ? count - 1 - i : i];
+        void* data = current->data;
+        if (copier && data) {
+            data = copier(data);
+            if (!data) {
+                // 中途复制失败：回滚已复制的数据，目标链表保持不变
+                while (i-- > 0) {
+                    size_t index = dest_list->reversed ? count - 1 - i : i;
+                    dest_list->free_data(nodes[index].data);
+                }
+                free(block);
+                return false;
+            }
+        }
+
+        node->data = data;
+        node->block = block;
+    }
+    for (i = 0; i < count; i++) {
+        nodes[i].prev = i > 0 ? &nodes[i - 1] : NULL;
+        nodes[i].next = i + 1 < count ? &nodes[i + 1] : NULL;
+    }
+
+    // 整段挂到目标链表的逻辑尾部
+    if (dest_list->reversed) {
+        link_run(dest_list, NULL, &nodes[0], &nodes[count - 1], dest_list->head, count);
+    } else {
+        link_run(dest_list, dest_list->tail, &nodes[0], &nodes[count - 1], NULL, count);
+    }
+    if (dest_list->journal) {
+        journal_inserted(dest_list, &nodes[dest_list->reversed ? count - 1 : 0], count,
+                         (int)(live_size(dest_list) - count));
+    }
+
+    return true;
+}
+
+bool copy_list(List* dest_list, List* src_list, copy_fn copier) {
+    if (!dest_list || !src_list || dest_list == src_list) return false;
+    TRACE_OP(TRACE_COPY, dest_list, -1, src_list);
+
+    return copy_nodes(dest_list, src_list, copier);
+}
+
+List* clone_list(List* src_list, copy_fn copier) {
+    if (!src_list) return NULL;
+
+    // 浅复制时数据与源链表共享，副本不持有数据
+    List* list = init_list(src_list->cmp, copier ? src_list->free_data : NULL);
+    if (!list) return NULL;
+
+    if (src_list->fingerprint) {
+        enable_fingerprint(list, src_list->hash);
+    }
+    if (src_list->filter) {
+        enable_filter(list, src_list->hash);
+    }
+    list->batch_cmp = src_list->batch_cmp;
+
+    if (!copy_nodes(list, src_list, copier)) {
+        destroy_list(list);
+        return NULL;
+    }
+    TRACE_OP(TRACE_CLONE, src_list, -1, list);
+    return list;
+}
+
+bool reverse_list(List* list) {
+    if (!list) return false;
+    TRACE_OP(TRACE_REVERSE, list, -1, NULL);
+
+    // 只翻转方向标志，不触碰任何节点；逻辑指纹随之改读另一方向
+    list->reversed = !list->reversed;
+    if (list->journal) list_journal_record(list, JOURNAL_REVERSE, -1, NULL, NULL);
+
+    return true;
+}
+
+bool materialize_list(List* list) {
+    if (!list) return false;
+    if (list->reversed) flip_links(list);
+    return true;
+}
+
+ListNode* get_first_node(List* list) {
+    return list ? first_live(list) : NULL;
+}
+
+ListNode* get_last_node(List* list) {
+    return list ? last_live(list) : NULL;
+}
+
+ListNode* get_next_node(List* list, ListNode* node) {
+    return list && node ? next_live(list, node) : NULL;
+}
+
+ListNode* get_prev_node(List* list, ListNode* node) {
+    return list && node ? prev_live(list, node) : NULL;
+}
+
+// ==================== 排序 ====================
+// 所有排序都只重新链接节点、不移动数据；基数排序先把 (键, 节点) 收集到数组中分桶，最后一次性重新链接
+// 排序与集合运算沿物理 next 方向工作，入口处先落实逆向标志（保证稳定性按逻辑顺序）
+
+// 节点已按新顺序双向链接：更新 head / tail 并重算指纹（成员不变，过滤器无需改动）
+static void set_order(List* list, ListNode* first, ListNode* last) {
+    list->head = first;
+    list->tail = last;
+    if (list->compact_cursor) list->compact_cursor = first;
+
+    if (list->fingerprint) {
+        list->fp_forward = fp_pair(FP_SENTINEL, FP_SENTINEL);
+        list->fp_backward = list->fp_forward;
+        fp_run(list, first, last, true);
+    }
+
+    // 整体重排：直接用快照重写日志
+    if (list->journal) list_journal_compact(list);
+}
+
+// 按 next 链恢复 prev 指针
+static void relink_chain(List* list, ListNode* first) {
+    ListNode* prev = NULL;
+    for (ListNode* node = first; node; node = node->next) {
+        node->prev = prev;
+        prev = node;
+    }
+    set_order(list, first, prev);
+}
+
+// 合并两条以 NULL 结尾的有序 next 链，相等时 a 在前（保持稳定）
+static ListNode* merge_chains(List* list, ListNode* a, ListNode* b) {
+    ListNode* first = NULL;
+    ListNode** out = &first;
+    while (a && b) {
+        if (list->cmp(a->data, b->data) <= 0) {
+            *out = a;
+            a = a->next;
+        } else {
+            *out = b;
+            b = b->next;
+        }
+        out = &(*out)->next;
+    }
+    *out = a ? a : b;
+    return first;
+}
+
+bool sort_list(List* list) {
+    if (!list || !list->cmp) return false;
+    TRACE_OP(TRACE_SORT, list, -1, NULL);
+    purge_tombstones(list);
+    if (list->size < 2) return true;
+    materialize_list(list);
+
+    // 自底向上归并：runs[k] 保存长度为 2^k 的有序段，新节点像二进制进位一样逐级合并
+    // 先合并刚访问过的小段，缓存局部性好于逐趟遍历整个链表
+    ListNode* runs[64] = {NULL};
+    ListNode* node = list->head;
+    while (node) {
+        ListNode* next = node->next;
+        node->next = NULL;
+
+        ListNode* carry = node;
+        int k = 0;
+        for (; runs[k]; k++) {
+            carry = merge_chains(list, runs[k], carry);
+            runs[k] = NULL;
+        }
+        runs[k] = carry;
+        node = next;
+    }
+
+    // 高位的段包含更早的元素，作为左侧参与合并
+    ListNode* first = NULL;
+    for (int k = 0; k < 64; k++) {
+        if (runs[k]) first = merge_chains(list, runs[k], first);
+    }
+
+    relink_chain(list, first);
+    return true;
+}
+
+#define RADIX_DIGITS 8
+
+typedef struct {
+    uint64_t key;
+    ListNode* node;
+} RadixEntry;
+
+bool sort_list_by_key(List* list, key_fn key) {
+    if (!list || !key) return false;
+    TRACE_OP(TRACE_SORT, list, -1, NULL);
+    purge_tombstones(list);
+    if (list->size < 2) return true;
+    materialize_list(list);
+
+    // 沿链表收集 (键, 节点) 后在数组上做计数排序，最后一次性重新链接：
+    // 每趟都是顺序读写，避免逐趟沿 next 随机访问节点
+    size_t count = list->size;
+    RadixEntry* entries = malloc(2 * count * sizeof(RadixEntry));
+    if (!entries) return false;
+    RadixEntry* from = entries;
+    RadixEntry* to = entries + count;
+
+    // 每个节点只调用一次 key，同时统计每个字节位的分布
+    size_t counts[RADIX_DIGITS][256] = {{0}};
+    size_t i = 0;
+    for (ListNode* node = list->head; node; node = node->next, i++) {
+        uint64_t k = key(node->data);
+        from[i].key = k;
+        from[i].node = node;
+        for (int digit = 0; digit < RADIX_DIGITS; digit++) {
+            counts[digit][(k >> (digit * 8)) & 0xff]++;
+        }
+    }
+
+    for (int digit = 0; digit < RADIX_DIGITS; digit++) {
+        int shift = digit * 8;
+        // 所有键在该字节位相同：这一趟不改变顺序，跳过
+        if (counts[digit][(from[0].key >> shift) & 0xff] == count) continue;
+
+        size_t offsets[256];
+        size_t offset = 0;
+        for (int b = 0; b < 256; b++) {
+            offsets[b] = offset;
+            offset += counts[digit][b];
+        }
+        for (i = 0; i < count; i++) {
+            to[offsets[(from[i].key >> shift) & 0xff]++] = from[i];
+        }
+
+        RadixEntry* swap = from;
+        from = to;
+        to = swap;
+    }
+
+    // 各节点的写入互不依赖，不会像沿 next 遍历那样串行等待缓存未命中
+    for (i = 0; i < count; i++) {
+        from[i].node->prev = i > 0 ? from[i - 1].node : NULL;
+        from[i].node->next = i + 1 < count ? from[i + 1].node : NULL;
+    }
+    set_order(list, from[0].node, from[count - 1].node);
+
+    free(entries);
+    return true;
+}
+
+typedef struct {
+    const unsigned char* bytes;
+    size_t length;
+    ListNode* node;
+} ByteEntry;
+
+// 待处理的区间 [begin, end)：区间内的键前 depth 个字节都相同
+typedef struct {
+    size_t begin;
+    size_t end;
+    size_t depth;
+} MsdRange;
+
+#define MSD_SMALL_RANGE 16
+
+// 两个键的前 depth 个字节已知相同，从 depth 开始比较
+static int byte_key_cmp(const ByteEntry* a, const ByteEntry* b, size_t depth) {
+    size_t length = a->length < b->length ? a->length : b->length;
+    if (length > depth) {
+        int result = memcmp(a->bytes + depth, b->bytes + depth, length - depth);
+        if (result != 0) return result;
+    }
+    return (a->length > b->length) - (a->length < b->length);
+}
+
+// 第 depth 个字节所在的桶，在 depth 处结束的键归入桶 0 排在最前
+static size_t byte_bucket(const ByteEntry* entry, size_t depth) {
+    return entry->length > depth ? (size_t)entry->bytes[depth] + 1 : 0;
+}
+
+// 按数组顺序重新链接所有节点
+static void relink_entries(List* list, ByteEntry* entries, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        entries[i].node->prev = i > 0 ? entries[i - 1].node : NULL;
+        entries[i].node->next = i + 1 < count ? entries[i + 1].node : NULL;
+    }
+    set_order(list, entries[0].node, entries[count - 1].node);
+}
+
+bool sort_list_by_bytes(List* list, bytes_key_fn key) {
+    if (!list || !key) return false;
+    TRACE_OP(TRACE_SORT, list, -1, NULL);
+    purge_tombstones(list);
+    if (list->size < 2) return true;
+    materialize_list(list);
+
+    // 与整数键相同，在 (键, 节点) 数组上分桶，最后一次性重新链接
+    size_t count = list->size;
+    ByteEntry* entries = malloc(2 * count * sizeof(ByteEntry));
+    size_t stack_capacity = 256;
+    MsdRange* stack = malloc(stack_capacity * sizeof(MsdRange));
+    if (!entries || !stack) {
+        free(entries);
+        free(stack);
+        return false;
+    }
+    ByteEntry* scratch = entries + count;
+
+    size_t i = 0;
+    for (ListNode* node = list->head; node; node = node->next, i++) {
+        entries[i].bytes = key(node->data, &entries[i].length);
+        entries[i].node = node;
+    }
+
+    // 用显式栈代替递归，长公共前缀不会导致栈溢出
+    bool ok = true;
+    size_t top = 0;
+    stack[top++] = (MsdRange){0, count, 0};
+    while (top > 0) {
+        MsdRange range = stack[--top];
+        size_t n = range.end - range.begin;
+        ByteEntry* base = entries + range.begin;
+
+        // 小区间：稳定插入排序
+        if (n <= MSD_SMALL_RANGE) {
+            for (size_t j = 1; j < n; j++) {
+                ByteEntry entry = base[j];
+                size_t k = j;
+                while (k > 0 && byte_key_cmp(&base[k - 1], &entry, range.depth) > 0) {
+                    base[k] = base[k - 1];
+                    k--;
+                }
+                base[k] = entry;
+            }
+            continue;
+        }
+
+        size_t counts[257] = {0};
+        for (size_t j = 0; j < n; j++) {
+            counts[byte_bucket(&base[j], range.depth)]++;
+        }
+
+        // 全部落在同一个非结束桶：无需移动，直接比较下一个字节
+        size_t only = byte_bucket(&base[0], range.depth);
+        if (only > 0 && counts[only] == n) {
+            range.depth++;
+            stack[top++] = range;
+            continue;
+        }
+
+        size_t offsets[257];
+        size_t offset = 0;
+        for (int b = 0; b < 257; b++) {
+            offsets[b] = offset;
+            offset += counts[b];
+        }
+        for (size_t j = 0; j < n; j++) {
+            scratch[offsets[byte_bucket(&base[j], range.depth)]++] = base[j];
+        }
+        memcpy(base, scratch, n * sizeof(ByteEntry));
+
+        if (top + 256 > stack_capacity) {
+            MsdRange* grown = realloc(stack, stack_capacity * 2 * sizeof(MsdRange));
+            if (!grown) {
+                // 无法继续细分：数组仍是全部节点的一个排列，按当前顺序链接后返回失败
+                ok = false;
+                break;
+            }
+            stack = grown;
+            stack_capacity *= 2;
+        }
+
+        // 桶 0 的键在 depth 处结束，彼此相等，已就位；其余非空桶继续按下一个字节排序
+        size_t begin = range.begin + counts[0];
+        for (int b = 1; b < 257; b++) {
+            if (counts[b] > 1) {
+                stack[top++] = (MsdRange){begin, begin + counts[b], range.depth + 1};
+            }
+            begin += counts[b];
+        }
+    }
+
+    relink_entries(list, entries, count);
+    free(stack);
+    free(entries);
+    return ok;
+}
+
+// ==================== 压缩 ====================
+// 按链表顺序把节点搬到新分配的连续块中，遍历时顺序访问内存；数据、顺序不变，指纹与过滤器无需改动
+// 嵌入数据时块内布局为 [节点0][数据0][节点1][数据1]...，cmp 访问数据时与节点位于同一区域
+
+#define COMPACT_ALIGN _Alignof(max_align_t)
+
+static size_t compact_stride(size_t payload_size) {
+    size_t stride = sizeof(ListNode) + payload_size;
+    return (stride + COMPACT_ALIGN - 1) / COMPACT_ALIGN * COMPACT_ALIGN;
+}
+
+// 把从 first 开始最多 max_nodes 个节点搬到一个新块，返回搬迁段之后的节点；*moved 为搬迁数量
+static ListNode* relocate_run(List* list, ListNode* first, size_t max_nodes, size_t payload_size, size_t* moved) {
+    *moved = 0;
+
+    // 不持有数据的链表无法释放旧数据，只搬迁节点
+    if (!list->free_data) payload_size = 0;
+
+    // 已嵌入的数据必须随节点一起搬走，槽位按两者中较大的分配
+    size_t count = 0;
+    size_t slot_size = payload_size;
+    ListNode* last = first;
+    for (ListNode* node = first; node && count < max_nodes; node = node->next) {
+        if (data_embedded(node) && node_block(node)->payload_size > slot_size) {
+            slot_size = node_block(node)->payload_size;
+        }
+        last = node;
+        count++;
+    }
+    if (count == 0) return NULL;
+
+    size_t stride = compact_stride(slot_size);
+    NodeBlock* block = malloc(sizeof(NodeBlock) + count * stride);
+    if (!block) return first;
+    block->live = count;
+    block->payload_size = slot_size;
+
+    ListNode* before = first->prev;
+    ListNode* after = last->next;
+    ListNode* prev = before;
+    ListNode* old = first;
+    for (size_t i = 0; i < count; i++) {
+        ListNode* node = (ListNode *)((char *)block->nodes + i * stride);
+        ListNode* next_old = old->next;
+
+        // 嵌入旧块的数据随旧块释放，单独分配的数据复制后由 free_data 释放
+        node->data = old->data;
+        if (data_embedded(old)) {
+            node->data = (char *)node + sizeof(ListNode);
+            memcpy(node->data, old->data, node_block(old)->payload_size);
+        } else if (payload_size > 0) {
+            node->data = (char *)node + sizeof(ListNode);
+            memcpy(node->data, old->data, payload_size);
+            list->free_data(old->data);
+        }
+        // 墓碑随节点搬迁，标记保留
+        node->block = (NodeBlock *)((uintptr_t)block | ((uintptr_t)old->block & NODE_TOMBSTONE));
+        node->prev = prev;
+        if (prev) {
+            prev->next = node;
+        } else {
+            list->head = node;
+        }
+
+        free_node(old);
+        prev = node;
+        old = next_old;
+    }
+
+    prev->next = after;
+    if (after) {
+        after->prev = prev;
+    } else {
+        list->tail = prev;
+    }
+
+    *moved = count;
+    return after;
+}
+
+bool compact_list(List* list, size_t payload_size) {
+    if (!list) return false;
+    TRACE_OP(TRACE_COMPACT, list, -1, NULL);
+    purge_tombstones(list);
+    if (!list->head) return true;
+
+    size_t moved;
+    relocate_run(list, list->head, list->size, payload_size, &moved);
+    list->compact_cursor = NULL;
+    return moved == list->size;
+}
+
+bool compact_list_step(List* list, size_t max_nodes, size_t payload_size) {
+    if (!list || max_nodes == 0) return false;
+    TRACE_OP(TRACE_COMPACT, list, max_nodes > INT32_MAX ? INT32_MAX : (int)max_nodes, NULL);
+
+    ListNode* start = list->compact_cursor ? list->compact_cursor : list->head;
+    if (!start) return true;
+
+    // 分配失败时游标不动，下次调用重试
+    size_t moved;
+    ListNode* next = relocate_run(list, start, max_nodes, payload_size, &moved);
+    if (moved == 0) {
+        list->compact_cursor = start;
+        return false;
+    }
+    list->compact_cursor = next;
+    return next == NULL;
+}
+
+// ==================== 有序集合运算 ====================
+// 两个链表均按 list1->cmp 升序；重复元素按多重集合处理：相等的元素一一配对，
+// 并集保留 max(m, n) 个、交集 min(m, n) 个、差集 max(m - n, 0) 个、对称差 |m - n| 个
+
+// 连续落在同一侧达到该次数后改用指数探测寻找这一段的终点
+#define GALLOP_MIN 7
+
+typedef struct {
+    List* a;
+    List* b;
+    List* out;          // 结果链表；NULL 表示原地运算，结果留在 a 中，b 变为空
+    bool keep_a_only;   // 保留只在 a 中出现的元素
+    bool keep_b_only;   // 保留只在 b 中出现的元素
+    bool keep_common;   // 保留配对元素中 a 的一份
+    bool keep_common_b; // 保留配对元素中 b 的一份（仅归并使用）
+    bool failed;        // 新建结果时分配节点失败
+} SetMerge;
+
+// 从 from 开始查找第一个不小于 key 的节点（NULL 表示都小于 key），*skipped 为其前小于 key 的节点数
+// 指数步长探测后在最后一段内二分：比较 O(log k) 次；链表无法随机访问，指针移动仍为 O(k)
+static ListNode* gallop(int (*cmp)(const void *, const void *), ListNode* from,
+                        const void* key, size_t* skipped) {
+    *skipped = 0;
+    if (!from || cmp(from->data, key) >= 0) return from;
+
+    ListNode* low = from;   // 已知小于 key
+    size_t low_index = 0;
+    ListNode* high;         // 已知不小于 key，与 low 相距 distance 个节点
+    size_t distance;
+    for (size_t step = 1; ; step *= 2) {
+        ListNode* probe = low;
+        size_t moved = 0;
+        while (moved < step && probe->next) {
+            probe = probe->next;
+            moved++;
+        }
+        if (moved > 0 && cmp(probe->data, key) >= 0) {
+            high = probe;
+            distance = moved;
+            break;
+        }
+        low = probe;
+        low_index += moved;
+        if (moved < step) {
+            // 已到达尾部，所有节点都小于 key
+            *skipped = low_index + 1;
+            return NULL;
+        }
+    }
+
+    while (distance > 1) {
+        size_t half = distance / 2;
+        ListNode* mid = low;
+        for (size_t i = 0; i < half; i++) {
+            mid = mid->next;
+        }
+        if (cmp(mid->data, key) < 0) {
+            low = mid;
+            low_index += half;
+            distance -= half;
+        } else {
+            high = mid;
+            distance = half;
+        }
+    }
+    *skipped = low_index + 1;
+    return high;
+}
+
+// 把节点段 [first, last] 的数据追加到结果链表（与源链表共享数据）
+static void copy_run(SetMerge* m, ListNode* first, ListNode* last) {
+    ListNode* end = last->next;
+    for (ListNode* node = first; node != end; node = node->next) {
+        ListNode* copy = create_node(node->data);
+        if (!copy) {
+            m->failed = true;
+            return;
+        }
+        link_node(m->out, m->out->tail, copy, NULL);
+    }
+}
+
+// 删除节点段 [first, last] 及其数据
+static void drop_run(List* list, ListNode* first, ListNode* last) {
+    ListNode* end = last->next;
+    for (ListNode* node = first; node != end; ) {
+        ListNode* next = node->next;
+        unlink_node(list, node);
+        release_node(list, node);
+        node = next;
+    }
+}
+
+static void emit_a(SetMerge* m, ListNode* first, ListNode* last, bool keep) {
+    if (m->out) {
+        if (keep) copy_run(m, first, last);
+    } else if (!keep) {
+        drop_run(m->a, first, last);
+    }
+}
+
+// b 中的 count 个节点 [first, last]；原地运算时保留的段整体移到 a 中 before 之前（NULL 表示尾部）
+static void emit_b(SetMerge* m, ListNode* first, ListNode* last, size_t count, ListNode* before, bool keep) {
+    if (m->out) {
+        if (keep) copy_run(m, first, last);
+    } else if (keep) {
+        unlink_run(m->b, first, last, count);
+        link_run(m->a, before ? before->prev : m->a->tail, first, last, before, count);
+    } else {
+        drop_run(m->b, first, last);
+    }
+}
+
+static void set_merge(SetMerge* m) {
+    materialize_list(m->a);
+    materialize_list(m->b);
+    purge_tombstones(m->a);
+    purge_tombstones(m->b);
+
+    int (*cmp)(const void *, const void *) = m->a->cmp;
+    ListNode* x = m->a->head;
+    ListNode* y = m->b->head;
+    int streak_a = 0;
+    int streak_b = 0;
+
+    while (x && y && !m->failed) {
+        int result = cmp(x->data, y->data);
+        if (result == 0) {
+            // 配对元素：a 的一份在前，b 的一份（若保留）紧随其后
+            ListNode* next_x = x->next;
+            ListNode* next_y = y->next;
+            emit_a(m, x, x, m->keep_common);
+            emit_b(m, y, y, 1, next_x, m->keep_common_b);
+            x = next_x;
+            y = next_y;
+            streak_a = 0;
+            streak_b = 0;
+        } else if (result < 0) {
+            streak_b = 0;
+            ListNode* end = x->next;
+            ListNode* last = x;
+            if (++streak_a >= GALLOP_MIN) {
+                // a 连续领先：一次找出 a 中所有小于 y 的节点
+                size_t count;
+                end = gallop(cmp, x, y->data, &count);
+                last = end ? end->prev : m->a->tail;
+                streak_a = 0;
+            }
+            emit_a(m, x, last, m->keep_a_only);
+            x = end;
+        } else {
+            streak_a = 0;
+            ListNode* end = y->next;
+            ListNode* last = y;
+            size_t count = 1;
+            if (++streak_b >= GALLOP_MIN) {
+                end = gallop(cmp, y, x->data, &count);
+                last = end ? end->prev : m->b->tail;
+                streak_b = 0;
+            }
+            emit_b(m, y, last, count, x, m->keep_b_only);
+            y = end;
+        }
+    }
+    if (m->failed) return;
+
+    // 剩余部分只在一侧出现；原地运算时保留 a 的剩余部分无需遍历，b 的剩余部分整段挂到尾部
+    if (x) emit_a(m, x, m->a->tail, m->keep_a_only);
+    if (y) emit_b(m, y, m->b->tail, m->b->size, NULL, m->keep_b_only);
+}
+
+// 新建结果链表：与源链表共享数据，结果不持有数据
+static List* set_result(List* list1, List* list2, bool keep_a_only, bool keep_b_only, bool keep_common) {
+    if (!list1 || !list2 || !list1->cmp) return NULL;
+
+    List* out = init_list(list1->cmp, NULL);
+    if (!out) return NULL;
+
+    SetMerge m = {list1, list2, out, keep_a_only, keep_b_only, keep_common, false, false};
+    set_merge(&m);
+    if (m.failed) {
+        destroy_list(out);
+        return NULL;
+    }
+    return out;
+}
+
+// 原地运算：结果留在 list1，list2 的节点移入 list1 或被删除，不分配新节点
+static bool set_inplace(List* list1, List* list2, bool keep_a_only, bool keep_b_only,
+                        bool keep_common, bool keep_common_b) {
+    if (!list1 || !list2 || list1 == list2 || !list1->cmp) return false;
+
+    if (list2->journal && list2->size > 0) list_journal_record(list2, JOURNAL_CLEAR, -1, NULL, NULL);
+
+    SetMerge m = {list1, list2, NULL, keep_a_only, keep_b_only, keep_common, keep_common_b, false};
+    set_merge(&m);
+    if (list1->journal) list_journal_compact(list1);
+    return true;
+}
+
+// 跟踪记录在 list1 上，另一个链表作为键（list1 为空时 list_trace_record 不记录）
+List* union_lists(List* list1, List* list2) {
+    TRACE_OP(TRACE_UNION, list1, -1, list2);
+    return set_result(list1, list2, true, true, true);
+}
+
+List* intersect_lists(List* list1, List* list2) {
+    TRACE_OP(TRACE_INTERSECT, list1, -1, list2);
+    return set_result(list1, list2, false, false, true);
+}
+
+List* difference_lists(List* list1, List* list2) {
+    TRACE_OP(TRACE_DIFFERENCE, list1, -1, list2);
+    return set_result(list1, list2, true, false, false);
+}
+
+List* symmetric_difference_lists(List* list1, List* list2) {
+    TRACE_OP(TRACE_SYMMETRIC_DIFFERENCE, list1, -1, list2);
+    return set_result(list1, list2, true, true, false);
+}
+
+bool union_lists_inplace(List* list1, List* list2) {
+    TRACE_OP(TRACE_UNION_INPLACE, list1, -1, list2);
+    return set_inplace(list1, list2, true, true, true, false);
+}
+
+bool intersect_lists_inplace(List* list1, List* list2) {
+    TRACE_OP(TRACE_INTERSECT_INPLACE, list1, -1, list2);
+    return set_inplace(list1, list2, false, false, true, false);
+}
+
+bool difference_lists_inplace(List* list1, List* list2) {
+    TRACE_OP(TRACE_DIFFERENCE_INPLACE, list1, -1, list2);
+    return set_inplace(list1, list2, true, false, false, false);
+}
+
+bool symmetric_difference_lists_inplace(List* list1, List* list2) {
+    TRACE_OP(TRACE_SYMMETRIC_DIFFERENCE_INPLACE, list1, -1, list2);
+    return set_inplace(list1, list2, true, true, false, false);
+}
+
+bool merge_sorted_lists(List* list1, List* list2) {
+    TRACE_OP(TRACE_MERGE, list1, -1, list2);
+    return set_inplace(list1, list2, true, true, true, true);
+}
+
+bool enable_fingerprint(List* list, hash_fn hash) {
+    if (!list || !hash) return false;
+
+    // 指纹与过滤器共用哈希函数，更换哈希时过滤器需一并重建
+    if (list->filter && list->hash != hash) {
+        list->hash = hash;
+        if (!filter_rebuild(list, list->filter->capacity)) {
+            disable_filter(list);
+        }
+    }
+    list->hash = hash;
+    list->fingerprint = true;
+    list->fp_forward = fp_pair(FP_SENTINEL, FP_SENTINEL);
+    list->fp_backward = list->fp_forward;
+    // 只重算指纹：track_linked 还会把每个元素再加入一次过滤器，反复重算会使计数器饱和
+    if (list->head) {
+        fp_run(list, list->head, list->tail, true);
+    }
+
+    return true;
+}
+
+void disable_fingerprint(List* list) {
+    if (!list) return;
+    list->fingerprint = false;
+}
+
+uint64_t get_fingerprint(List* list) {
+    if (!list || !list->fingerprint) return 0;
+    return list->reversed ? list->fp_backward : list->fp_forward;
+}
+
+bool compare_lists(List* list1, List* list2) {
+    if (!list1 || !list2) return list1 == list2;
+    if (list1 == list2) return true;
+    TRACE_OP(TRACE_COMPARE, list1, -1, list2);
+
+    if (live_size(list1) != live_size(list2)) return false;
+
+    // 指纹不同则必然不等；指纹相同时仍需逐个比较排除碰撞（指纹包含墓碑，有墓碑时不可用）
+    if (list1->fingerprint && list2->fingerprint && list1->hash == list2->hash &&
+        list1->tombstones == 0 && list2->tombstones == 0 &&
+        get_fingerprint(list1) != get_fingerprint(list2)) {
+        return false;
+    }
+
+    ListNode* a = first_live(list1);
+    ListNode* b = first_live(list2);
+    for (; a && b; a = next_live(list1, a), b = next_live(list2, b)) {
+        if (list1->cmp ? list1->cmp(a->data, b->data) != 0 : a->data != b->data) {
+            return false;
+        }
+    }
+    return a == NULL && b == NULL;
+}
+
+bool concat_lists(List* list1, List* list2) {
+    if (!list1 || !list2 || list1 == list2) return false;
+    TRACE_OP(TRACE_CONCAT, list1, -1, list2);
+    purge_tombstones(list2);
+    if (!list2->head) return true;
+
+    // 整段摘下 list2 的节点挂到 list1 逻辑尾部，O(1)（启用指纹时需对挂入的段计算哈希）
+    // 两者方向不同时须先把 list2 的物理链接翻转到与 list1 一致，O(n)
+    if (list1->reversed != list2->reversed) flip_links(list2);
+
+    ListNode* first = list2->head;
+    ListNode* last = list2->tail;
+    size_t count = list2->size;
+    if (list2->journal) list_journal_record(list2, JOURNAL_CLEAR, -1, NULL, NULL);
+    reset_links(list2);
+
+    if (list1->reversed) {
+        link_run(list1, NULL, first, last, list1->head, count);
+    } else {
+        link_run(list1, list1->tail, first, last, NULL, count);
+    }
+    if (list1->journal) {
+        journal_inserted(list1, list1->reversed ? last : first, count, (int)(live_size(list1) - count));
+    }
+
+    return true;
+}
+
+bool enable_deferred_delete(List* list, double purge_ratio) {
+    if (!list || purge_ratio < 0) return false;
+    list->deferred_delete = true;
+    list->purge_ratio = purge_ratio;
+    return true;
+}
+
+void disable_deferred_delete(List* list) {
+    if (!list) return;
+    purge_tombstones(list);
+    list->deferred_delete = false;
+}
+
+// 一趟摘下并释放除 keep 以外的所有墓碑
+static size_t purge_except(List* list, ListNode* keep) {
+    size_t purged = 0;
+    ListNode* node = list->head;
+    while (node) {
+        ListNode* next = node->next;
+        if (node != keep && is_tombstone(node)) {
+            unlink_node(list, node);
+            release_node(list, node);
+            purged++;
+        }
+        node = next;
+    }
+    list->tombstones -= purged;
+    return purged;
+}
+
+size_t purge_tombstones(List* list) {
+    if (!list || list->tombstones == 0) return 0;
+    return purge_except(list, NULL);
+}
+
+void set_batch_cmp(List* list, batch_cmp_fn batch_cmp) {
+    if (!list) return;
+    list->batch_cmp = batch_cmp;
+}
+
+bool enable_filter(List* list, hash_fn hash) {
+    if (!list || !hash) return false;
+
+    bool rehash = list->hash != hash;
+    list->hash = hash;
+    if (list->fingerprint && rehash) {
+        enable_fingerprint(list, hash);
+    }
+
+    if (!list->filter) {
+        list->filter = calloc(1, sizeof(ListFilter));
+        if (!list->filter) return false;
+    }
+    if (!filter_rebuild(list, list->size)) {
+        free(list->filter);
+        list->filter = NULL;
+        return false;
+    }
+    return true;
+}
+
+void disable_filter(List* list) {
+    if (!list || !list->filter) return;
+
+    free(list->filter->counters);
+    free(list->filter);
+    list->filter = NULL;
+}
+
+bool filter_may_contain(List* list, const void* key) {
+    if (!list) return false;
+    if (!list->filter) return true;
+
+    list->filter->lookups++;
+    if (!filter_test(list->filter, list->hash(key))) {
+        list->filter->rejected++;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,438 @@
+#include <fcntl.h>
+#include <libgen.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "list_journal.h"
+
+static const char journal_magic[8] = {'L', 'J', 'O', 'U', 'R', 'N', 'A', 'L'};
+
+#define JOURNAL_WRITE_CHUNK (1 << 20)
+#define JOURNAL_COMPACT_SLACK 64    // 记录数超过快照记录数的两倍再加这么多时自动压缩
+
+static uint64_t now_nanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void put_u32(unsigned char* buf, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        buf[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+static uint32_t get_u32(const unsigned char* buf) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        value |= (uint32_t)buf[i] << (8 * i);
+    }
+    return value;
+}
+
+// FNV-1a，用于发现末尾写了一半的记录
+static uint32_t checksum(const unsigned char* buf, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= buf[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static bool write_all(int fd, const void* buf, size_t length) {
+    const unsigned char* p = buf;
+    while (length > 0) {
+        ssize_t written = write(fd, p, length);
+        if (written <= 0) return false;
+        p += written;
+        length -= (size_t)written;
+    }
+    return true;
+}
+
+static bool reserve(ListJournal* journal, size_t extra) {
+    size_t size = journal->used + extra;
+    if (size <= journal->buffer_size) return true;
+
+    size_t new_size = journal->buffer_size ? journal->buffer_size : 4096;
+    while (new_size < size) {
+        new_size *= 2;
+    }
+    unsigned char* buffer = realloc(journal->buffer, new_size);
+    if (!buffer) return false;
+
+    journal->buffer = buffer;
+    journal->buffer_size = new_size;
+    return true;
+}
+
+// 把数据序列化到缓冲末尾，返回字节数；失败返回 SIZE_MAX
+static size_t put_payload(ListJournal* journal, const void* data) {
+    if (!data) return 0;
+
+    for (;;) {
+        size_t room = journal->buffer_size - journal->used;
+        size_t length = journal->serialize(data, journal->buffer + journal->used, room);
+        if (length <= room) {
+            journal->used += length;
+            return length;
+        }
+        if (length > UINT32_MAX || !reserve(journal, length)) return SIZE_MAX;
+    }
+}
+
+// 编码一条记录追加到缓冲，不提交
+static bool encode_record(ListJournal* journal, JournalOp op, int position, const void* key, const void* data) {
+    size_t start = journal->used;
+    if (!reserve(journal, JOURNAL_RECORD_HEADER)) return false;
+    journal->used += JOURNAL_RECORD_HEADER;
+
+    size_t key_length = put_payload(journal, key);
+    size_t data_length = key_length == SIZE_MAX ? SIZE_MAX : put_payload(journal, data);
+    if (data_length == SIZE_MAX || !reserve(journal, 4)) {
+        journal->used = start;
+        return false;
+    }
+
+    unsigned char* record = journal->buffer + start;
+    record[0] = (unsigned char)op;
+    put_u32(record + 1, (uint32_t)position);
+    put_u32(record + 5, (uint32_t)key_length);
+    put_u32(record + 9, (uint32_t)data_length);
+    put_u32(journal->buffer + journal->used, checksum(record, journal->used - start));
+    journal->used += 4;
+    journal->records++;
+    return true;
+}
+
+// 标记日志失效并报告一次；之后的修改不再记录，直到 list_journal_compact 用快照重建日志
+static void mark_failed(ListJournal* journal) {
+    if (!journal->failed) {
+        fprintf(stderr, "Error: journal %s stopped recording, call list_journal_compact to recover\n", journal->path);
+    }
+    journal->failed = true;
+}
+
+static bool flush_buffer(ListJournal* journal, int fd) {
+    if (journal->used == 0) return true;
+
+    bool ok = write_all(fd, journal->buffer, journal->used);
+    journal->used = 0;
+    return ok;
+}
+
+void list_journal_record(List* list, JournalOp op, int position, const void* key, const void* data) {
+    ListJournal* journal = list->journal;
+    if (!journal || journal->failed) return;
+
+    if (!encode_record(journal, op, position, key, data)) {
+        mark_failed(journal);
+        return;
+    }
+
+    // 组提交：第一条记录开始计时，条数或等待时间到达阈值时一次写出并同步
+    uint64_t now = journal->group_nanos ? now_nanos() : 0;
+    if (journal->pending++ == 0) journal->pending_since = now;
+    if (journal->pending >= journal->group_records ||
+        (journal->group_nanos && now - journal->pending_since >= journal->group_nanos)) {
+        list_journal_commit(list);
+    }
+}
+
+bool list_journal_poll(List* list) {
+    if (!list || !list->journal) return false;
+
+    ListJournal* journal = list->journal;
+    if (journal->pending == 0 || journal->group_nanos == 0) return false;
+    if (now_nanos() - journal->pending_since < journal->group_nanos) return false;
+    list_journal_commit(list);
+    return true;
+}
+
+int list_journal_poll_timeout(List* list) {
+    if (!list || !list->journal) return -1;
+
+    ListJournal* journal = list->journal;
+    if (journal->pending == 0 || journal->group_nanos == 0) return -1;
+    uint64_t waited = now_nanos() - journal->pending_since;
+    if (waited >= journal->group_nanos) return 0;
+    uint64_t millis = (journal->group_nanos - waited + 999999) / 1000000;
+    return millis > INT32_MAX ? INT32_MAX : (int)millis;
+}
+
+static void compact_committed(List* list, ListJournal* journal);
+
+// 写出并同步缓冲中的一组记录
+static bool commit_group(ListJournal* journal) {
+    if (journal->pending == 0) return !journal->failed;
+
+    if (!flush_buffer(journal, journal->fd) || fdatasync(journal->fd) != 0) {
+        mark_failed(journal);
+    }
+    journal->pending = 0;
+    journal->commits++;
+    return !journal->failed;
+}
+
+bool list_journal_commit(List* list) {
+    if (!list || !list->journal) return false;
+
+    ListJournal* journal = list->journal;
+    if (!commit_group(journal)) return false;
+    if (journal->records > journal->compact_at) {
+        compact_committed(list, journal);
+    }
+    return true;
+}
+
+// ==================== 回放 ====================
+
+// 释放回放时反序列化出、没有交给链表的键或数据
+static void free_payload(List* list, void* payload) {
+    if (list->free_data) {
+        list->free_data(payload);
+    } else {
+        free(payload);
+    }
+}
+
+static bool apply_record(List* list, ListJournal* journal, const unsigned char* record) {
+    JournalOp op = record[0];
+    int position = (int)get_u32(record + 1);
+    size_t key_length = get_u32(record + 5);
+    size_t data_length = get_u32(record + 9);
+    const unsigned char* key_bytes = record + JOURNAL_RECORD_HEADER;
+    const unsigned char* data_bytes = key_bytes + key_length;
+
+    switch (op) {
+    case JOURNAL_INSERT: {
+        // 损坏的日志中位置可能越界：插入失败时数据仍归回放所有
+        void* data = journal->deserialize(data_bytes, data_length);
+        if (position >= 0 && position <= (int)get_length(list) && insert_at_position(list, data, position)) {
+            return true;
+        }
+        free_payload(list, data);
+        return false;
+    }
+    case JOURNAL_DELETE:
+        return delete_at_position(list, position);
+    case JOURNAL_DELETE_KEY: {
+        void* key = journal->deserialize(key_bytes, key_length);
+        bool ok = delete_by_value(list, key);
+        free_payload(list, key);
+        return ok;
+    }
+    case JOURNAL_UPDATE:
+    case JOURNAL_UPDATE_KEY: {
+        ListNode* node;
+        if (op == JOURNAL_UPDATE) {
+            node = get_node_at_position(list, position);
+        } else {
+            void* key = journal->deserialize(key_bytes, key_length);
+            node = search_by_value(list, key);
+            free_payload(list, key);
+        }
+        if (!node) return false;
+
+        void* data = journal->deserialize(data_bytes, data_length);
+        if (replace_node_data(list, node, data)) return true;
+        free_payload(list, data);
+        return false;
+    }
+    case JOURNAL_CLEAR:
+        clear_list(list);
+        return true;
+    case JOURNAL_REVERSE:
+        return reverse_list(list);
+    default:
+        return false;
+    }
+}
+
+// 逐条回放，返回最后一条完整记录之后的偏移
+static size_t replay(List* list, ListJournal* journal, const unsigned char* buf, size_t length) {
+    size_t offset = sizeof(journal_magic);
+    while (offset + JOURNAL_RECORD_HEADER + 4 <= length) {
+        const unsigned char* record = buf + offset;
+        size_t body = JOURNAL_RECORD_HEADER + (size_t)get_u32(record + 5) + get_u32(record + 9);
+        if (body + 4 > length - offset) break;
+        if (get_u32(record + body) != checksum(record, body)) break;
+
+        if (!apply_record(list, journal, record)) {
+            fprintf(stderr, "Error: journal record at offset %zu does not apply\n", offset);
+        }
+        journal->records++;
+        offset += body + 4;
+    }
+    return offset;
+}
+
+// 读入整个日志文件并检查文件头，失败返回 NULL
+static unsigned char* read_log(int fd, size_t length) {
+    unsigned char* buf = malloc(length);
+    if (!buf) return NULL;
+    if (pread(fd, buf, length, 0) != (ssize_t)length ||
+        memcmp(buf, journal_magic, sizeof(journal_magic)) != 0) {
+        free(buf);
+        return NULL;
+    }
+    return buf;
+}
+
+// 读取并回放已有日志；新文件写入文件头
+static bool load(List* list, ListJournal* journal) {
+    struct stat st;
+    if (fstat(journal->fd, &st) != 0) return false;
+
+    size_t length = (size_t)st.st_size;
+    if (length < sizeof(journal_magic)) {
+        return ftruncate(journal->fd, 0) == 0 &&
+               write_all(journal->fd, journal_magic, sizeof(journal_magic)) &&
+               fdatasync(journal->fd) == 0;
+    }
+
+    unsigned char* buf = read_log(journal->fd, length);
+    if (!buf) return false;
+
+    size_t end = replay(list, journal, buf, length);
+    free(buf);
+
+    // 截掉崩溃时写了一半的尾部，之后的追加从完整记录之后开始
+    return end == length || ftruncate(journal->fd, (off_t)end) == 0;
+}
+
+static void journal_free(ListJournal* journal) {
+    if (journal->fd >= 0) close(journal->fd);
+    free(journal->buffer);
+    free(journal->path);
+    free(journal);
+}
+
+bool list_journal_open(List* list, const char* path, serialize_fn serialize, deserialize_fn deserialize,
+                       size_t group_records, uint64_t group_micros) {
+    if (!list || !path || !serialize || !deserialize || list->journal || list->size > 0) return false;
+
+    ListJournal* journal = calloc(1, sizeof(ListJournal));
+    if (!journal) return false;
+    journal->path = strdup(path);
+    journal->serialize = serialize;
+    journal->deserialize = deserialize;
+    journal->group_records = group_records ? group_records : 1;
+    journal->group_nanos = group_micros * 1000;
+    journal->fd = open(path, O_RDWR | O_CREAT | O_APPEND, 0644);
+
+    // 回放期间 list->journal 为空，回放的操作不会再次记录
+    if (!journal->path || journal->fd < 0 || !load(list, journal)) {
+        journal_free(journal);
+        clear_list(list);
+        return false;
+    }
+    list->journal = journal;
+
+    journal->compact_at = 2 * get_length(list) + JOURNAL_COMPACT_SLACK;
+    if (journal->records > journal->compact_at) {
+        list_journal_compact(list);
+    }
+    return true;
+}
+
+// ==================== 压缩 ====================
+
+// rename 之后同步目录，保证新文件名本身已持久化
+static void sync_parent(const char* path) {
+    char* copy = strdup(path);
+    if (!copy) return;
+
+    int fd = open(dirname(copy), O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+    free(copy);
+}
+
+// 用 source 的快照原子地重写日志：写临时文件、同步后改名替换。调用时缓冲须为空
+static bool write_snapshot(ListJournal* journal, List* source) {
+    size_t path_length = strlen(journal->path);
+    char* tmp_path = malloc(path_length + 5);
+    if (!tmp_path) return false;
+    memcpy(tmp_path, journal->path, path_length);
+    memcpy(tmp_path + path_length, ".tmp", 5);
+
+    int fd = open(tmp_path, O_RDWR | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    bool ok = fd >= 0 && write_all(fd, journal_magic, sizeof(journal_magic));
+
+    // 快照：按逻辑顺序逐个写入插入记录，缓冲满 1MB 写出一次
+    size_t records = journal->records;
+    journal->records = 0;
+    int position = 0;
+    for (ListNode* node = get_first_node(source); node && ok; node = get_next_node(source, node)) {
+        ok = encode_record(journal, JOURNAL_INSERT, position++, NULL, node->data);
+        if (ok && journal->used >= JOURNAL_WRITE_CHUNK) ok = flush_buffer(journal, fd);
+    }
+    ok = ok && flush_buffer(journal, fd) && fdatasync(fd) == 0 && rename(tmp_path, journal->path) == 0;
+    journal->used = 0;
+
+    if (!ok) {
+        if (fd >= 0) close(fd);
+        unlink(tmp_path);
+        free(tmp_path);
+        journal->records = records;
+        return false;
+    }
+    sync_parent(journal->path);
+    free(tmp_path);
+
+    close(journal->fd);
+    journal->fd = fd;
+    journal->compact_at = 2 * journal->records + JOURNAL_COMPACT_SLACK;
+    return true;
+}
+
+// 提交后的自动压缩可能发生在一次修改的中途（各操作记录与修改链表的先后不同），不能对链表本身做快照：
+// 把已提交的日志回放到临时链表，用它的快照重写日志。失败时保留原日志，记录数再翻倍后重试
+static void compact_committed(List* list, ListJournal* journal) {
+    size_t records = journal->records;
+    List* scratch = init_list(list->cmp, list->free_data ? list->free_data : free);
+    struct stat st;
+    unsigned char* buf = NULL;
+    if (scratch && fstat(journal->fd, &st) == 0) {
+        buf = read_log(journal->fd, (size_t)st.st_size);
+    }
+
+    bool ok = false;
+    if (buf) {
+        replay(scratch, journal, buf, (size_t)st.st_size);
+        journal->records = records;
+        ok = write_snapshot(journal, scratch);
+    }
+    if (!ok) journal->compact_at = 2 * records;
+
+    free(buf);
+    destroy_list(scratch);
+}
+
+bool list_journal_compact(List* list) {
+    if (!list || !list->journal) return false;
+
+    // 先提交，快照失败时旧日志仍然完整；日志已失效时缓冲中的记录残缺，直接丢弃，由快照恢复
+    ListJournal* journal = list->journal;
+    if (!journal->failed) commit_group(journal);
+    journal->used = 0;
+    journal->pending = 0;
+
+    if (!write_snapshot(journal, list)) return false;
+    journal->failed = false;
+    return true;
+}
+
+bool list_journal_close(List* list) {
+    if (!list || !list->journal) return false;
+
+    bool ok = list_journal_commit(list) && !list->journal->failed;
+    journal_free(list->journal);
+    list->journal = NULL;
+    return ok;
+}
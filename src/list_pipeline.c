@@ -0,0 +1,193 @@
+#include "list_pipeline.h"
+
+// 终结操作的接收端
+typedef enum {
+    SINK_MORE,              // 继续送入元素
+    SINK_STOP,              // 已得到结果，不再需要元素
+    SINK_ERROR,             // 出错，终结操作失败
+} SinkResult;
+
+typedef SinkResult (*pipe_sink_fn)(void *value, void *ctx);
+
+ListPipeline list_pipe(List* list) {
+    ListPipeline pipe;
+    pipe.list = list;
+    pipe.stage_count = 0;
+    pipe.overflow = false;
+    return pipe;
+}
+
+static PipeStage* add_stage(ListPipeline* pipe, PipeStageKind kind) {
+    if (!pipe) return NULL;
+    if (pipe->stage_count == PIPE_MAX_STAGES) {
+        pipe->overflow = true;
+        return NULL;
+    }
+
+    PipeStage* stage = &pipe->stages[pipe->stage_count++];
+    stage->kind = kind;
+    stage->pred = NULL;
+    stage->map = NULL;
+    stage->when = NULL;
+    stage->update = NULL;
+    stage->ctx = NULL;
+    stage->limit = 0;
+    stage->passed = 0;
+    return stage;
+}
+
+ListPipeline* pipe_filter(ListPipeline* pipe, pipe_pred_fn pred, void* ctx) {
+    PipeStage* stage = add_stage(pipe, PIPE_FILTER);
+    if (stage) {
+        stage->pred = pred;
+        stage->ctx = ctx;
+    }
+    return pipe;
+}
+
+ListPipeline* pipe_map(ListPipeline* pipe, pipe_map_fn map, void* ctx) {
+    PipeStage* stage = add_stage(pipe, PIPE_MAP);
+    if (stage) {
+        stage->map = map;
+        stage->ctx = ctx;
+    }
+    return pipe;
+}
+
+ListPipeline* pipe_update(ListPipeline* pipe, predicate_fn pred, const void* new_value, update_fn updater) {
+    PipeStage* stage = add_stage(pipe, PIPE_UPDATE);
+    if (stage) {
+        stage->when = pred;
+        stage->update = updater;
+        stage->ctx = (void*)new_value;
+    }
+    return pipe;
+}
+
+ListPipeline* pipe_take_while(ListPipeline* pipe, pipe_pred_fn pred, void* ctx) {
+    PipeStage* stage = add_stage(pipe, PIPE_TAKE_WHILE);
+    if (stage) {
+        stage->pred = pred;
+        stage->ctx = ctx;
+    }
+    return pipe;
+}
+
+ListPipeline* pipe_limit(ListPipeline* pipe, size_t limit) {
+    PipeStage* stage = add_stage(pipe, PIPE_LIMIT);
+    if (stage) stage->limit = limit;
+    return pipe;
+}
+
+// 融合执行：每个节点依次经过所有阶段后交给接收端，任何阶段要求结束时立即停止遍历。
+// 提前结束仍返回 true，只有阶段数溢出或接收端出错时返回 false
+static bool pipe_run(ListPipeline* pipe, pipe_sink_fn sink, void* sink_ctx) {
+    if (!pipe || !pipe->list || pipe->overflow) return false;
+
+    PipeStage* stages = pipe->stages;
+    size_t stage_count = pipe->stage_count;
+    for (size_t i = 0; i < stage_count; i++) {
+        stages[i].passed = 0;
+        // 上限为 0 的 limit 不放行任何元素，无需遍历
+        if (stages[i].kind == PIPE_LIMIT && stages[i].limit == 0) return true;
+    }
+
+    List* list = pipe->list;
+    bool reversed = list->reversed;
+    ListNode* node = reversed ? list->tail : list->head;
+    int position = -1;  // 当前节点的逻辑位置，供 update 阶段写日志
+    while (node) {
+        ListNode* current = node;
+        void* value = node->data;
+        bool dead = is_tombstone(node);
+        node = reversed ? node->prev : node->next;
+        if (dead) continue;
+        position++;
+
+        bool keep = true;
+        bool last = false;   // 本元素之后不再有元素能到达末端
+        for (size_t i = 0; i < stage_count && keep; i++) {
+            PipeStage* stage = &stages[i];
+            switch (stage->kind) {
+            case PIPE_FILTER:
+                keep = stage->pred(value, stage->ctx);
+                break;
+            case PIPE_MAP:
+                value = stage->map(value, stage->ctx);
+                break;
+            case PIPE_UPDATE:
+                if (!stage->when || stage->when(current->data)) {
+                    update_node_at(list, current, position, stage->ctx, stage->update);
+                }
+                break;
+            case PIPE_TAKE_WHILE:
+                if (!stage->pred(value, stage->ctx)) return true;
+                break;
+            case PIPE_LIMIT:
+                if (++stage->passed == stage->limit) last = true;
+                break;
+            }
+        }
+
+        if (keep) {
+            SinkResult result = sink(value, sink_ctx);
+            if (result == SINK_ERROR) return false;
+            if (result == SINK_STOP) return true;
+        }
+        if (last) return true;
+    }
+    return true;
+}
+
+static SinkResult count_sink(void* value, void* ctx) {
+    (void)value;
+    (*(size_t*)ctx)++;
+    return SINK_MORE;
+}
+
+size_t pipe_count(ListPipeline* pipe) {
+    size_t count = 0;
+    pipe_run(pipe, count_sink, &count);
+    return count;
+}
+
+static SinkResult collect_sink(void* value, void* ctx) {
+    return insert_at_tail(ctx, value) ? SINK_MORE : SINK_ERROR;
+}
+
+bool pipe_collect(ListPipeline* pipe, List* dest) {
+    if (!dest || (pipe && dest == pipe->list)) return false;
+    return pipe_run(pipe, collect_sink, dest);
+}
+
+static SinkResult find_sink(void* value, void* ctx) {
+    *(void**)ctx = value;
+    return SINK_STOP;
+}
+
+void* pipe_find_first(ListPipeline* pipe) {
+    void* found = NULL;
+    pipe_run(pipe, find_sink, &found);
+    return found;
+}
+
+typedef struct {
+    void (*fn)(void *data, void *ctx);
+    void* ctx;
+    size_t count;
+} ForEachSink;
+
+static SinkResult for_each_sink(void* value, void* ctx) {
+    ForEachSink* sink = ctx;
+    sink->fn(value, sink->ctx);
+    sink->count++;
+    return SINK_MORE;
+}
+
+size_t pipe_for_each(ListPipeline* pipe, void (*fn)(void *data, void *ctx), void* ctx) {
+    if (!fn) return 0;
+
+    ForEachSink sink = {fn, ctx, 0};
+    pipe_run(pipe, for_each_sink, &sink);
+    return sink.count;
+}
@@ -0,0 +1,527 @@
+#include <string.h>
+#include <time.h>
+#include "list_trace.h"
+
+static const char trace_magic[8] = {'L', 'T', 'R', 'A', 'C', 'E', 0, 1};
+
+static FILE* trace_file = NULL;
+static bool trace_env_checked = false;
+static uint64_t trace_start = 0;
+static size_t trace_count = 0;
+
+static uint64_t now_nanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void put_u32(unsigned char* buf, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        buf[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+static void put_u64(unsigned char* buf, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        buf[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+static uint32_t get_u32(const unsigned char* buf) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        value |= (uint32_t)buf[i] << (8 * i);
+    }
+    return value;
+}
+
+static uint64_t get_u64(const unsigned char* buf) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value |= (uint64_t)buf[i] << (8 * i);
+    }
+    return value;
+}
+
+static void encode_record(unsigned char* buf, const TraceRecord* record) {
+    buf[0] = record->op;
+    put_u32(buf + 1, record->list_id);
+    put_u32(buf + 5, (uint32_t)record->position);
+    put_u32(buf + 9, record->size);
+    put_u32(buf + 13, record->key_hash);
+    put_u64(buf + 17, record->timestamp);
+}
+
+static void decode_record(const unsigned char* buf, TraceRecord* record) {
+    record->op = buf[0];
+    record->list_id = get_u32(buf + 1);
+    record->position = (int32_t)get_u32(buf + 5);
+    record->size = get_u32(buf + 9);
+    record->key_hash = get_u32(buf + 13);
+    record->timestamp = get_u64(buf + 17);
+}
+
+// 地址混合成 32 位值，用作链表标识和未设置 hash 时的元素身份
+static uint32_t mix_pointer(const void* pointer) {
+    uint64_t x = (uint64_t)(uintptr_t)pointer;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return (uint32_t)x;
+}
+
+static uint32_t list_id_of(const List* list) {
+    return mix_pointer(list);
+}
+
+static bool op_takes_list(TraceOp op) {
+    switch (op) {
+    case TRACE_COPY:
+    case TRACE_CLONE:
+    case TRACE_COMPARE:
+    case TRACE_CONCAT:
+    case TRACE_UNION:
+    case TRACE_INTERSECT:
+    case TRACE_DIFFERENCE:
+    case TRACE_SYMMETRIC_DIFFERENCE:
+    case TRACE_UNION_INPLACE:
+    case TRACE_INTERSECT_INPLACE:
+    case TRACE_DIFFERENCE_INPLACE:
+    case TRACE_SYMMETRIC_DIFFERENCE_INPLACE:
+    case TRACE_MERGE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// 按值查找的键（其余操作的 key 是链表中的数据）
+static bool op_takes_lookup_key(TraceOp op) {
+    return op == TRACE_SEARCH || op == TRACE_SEARCH_REVERSE ||
+           op == TRACE_DELETE_VALUE || op == TRACE_UPDATE_VALUE;
+}
+
+// 未设置 hash 时把键换成逻辑顺序上第一个（反向查找为最后一个）与之相等的元素的数据，
+// 直接沿链接读取，不经过会再次记录的公共操作
+static const void* resolve_key(List* list, const void* key, bool last) {
+    if (!list->cmp) return key;
+
+    bool along_next = last == list->reversed;
+    for (ListNode* node = along_next ? list->head : list->tail; node; node = along_next ? node->next : node->prev) {
+        if (!is_tombstone(node) && list->cmp(node->data, key) == 0) return node->data;
+    }
+    return key;
+}
+
+static uint32_t key_hash_of(TraceOp op, List* list, const void* key) {
+    if (!key) return 0;
+    if (op_takes_list(op)) return list_id_of(key);
+    if (list->hash) return (uint32_t)list->hash(key);
+    if (op_takes_lookup_key(op)) key = resolve_key(list, key, op == TRACE_SEARCH_REVERSE);
+    return mix_pointer(key);
+}
+
+bool list_trace_open(const char* path) {
+    if (!path) return false;
+
+    list_trace_close();
+    trace_file = fopen(path, "wb");
+    if (!trace_file) return false;
+
+    setvbuf(trace_file, NULL, _IOFBF, 1 << 20);
+    if (fwrite(trace_magic, 1, sizeof(trace_magic), trace_file) != sizeof(trace_magic)) {
+        fclose(trace_file);
+        trace_file = NULL;
+        return false;
+    }
+
+    trace_start = now_nanos();
+    trace_count = 0;
+    return true;
+}
+
+void list_trace_close(void) {
+    if (!trace_file) return;
+    fclose(trace_file);
+    trace_file = NULL;
+}
+
+void list_trace_record(TraceOp op, List* list, int position, const void* key) {
+    if (!list) return;
+    if (!trace_file) {
+        if (trace_env_checked) return;
+        trace_env_checked = true;
+
+        const char* path = getenv("LIST_TRACE_FILE");
+        if (!path || !list_trace_open(path)) return;
+        atexit(list_trace_close);
+    }
+
+    TraceRecord record;
+    record.op = (uint8_t)op;
+    record.list_id = list_id_of(list);
+    record.position = position;
+    record.size = (uint32_t)(list->size - list->tombstones);
+    record.key_hash = key_hash_of(op, list, key);
+    record.timestamp = now_nanos() - trace_start;
+
+    unsigned char buf[TRACE_RECORD_BYTES];
+    encode_record(buf, &record);
+    fwrite(buf, 1, sizeof(buf), trace_file);
+    trace_count++;
+}
+
+size_t list_trace_count(void) {
+    return trace_count;
+}
+
+static int cmp_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return x < y ? -1 : (x > y);
+}
+
+bool list_trace_replay(const char* path, const TraceBackend* backend, TraceReplayStats* stats) {
+    if (!path || !backend || !stats) return false;
+
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+
+    char magic[sizeof(trace_magic)];
+    if (fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+        memcmp(magic, trace_magic, sizeof(magic)) != 0) {
+        fclose(file);
+        return false;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    size_t capacity = 1024;
+    uint64_t* latencies = malloc(capacity * sizeof(uint64_t));
+    void* ctx = backend->create();
+    if (!latencies || !ctx) {
+        free(latencies);
+        if (ctx) backend->destroy(ctx);
+        fclose(file);
+        return false;
+    }
+
+    unsigned char buf[TRACE_RECORD_BYTES];
+    TraceRecord record;
+    while (fread(buf, 1, sizeof(buf), file) == sizeof(buf)) {
+        decode_record(buf, &record);
+        if (record.op >= TRACE_OP_COUNT) continue;
+
+        uint64_t start = now_nanos();
+        backend->execute(ctx, &record);
+        uint64_t elapsed = now_nanos() - start;
+
+        if (stats->ops == capacity) {
+            uint64_t* grown = realloc(latencies, capacity * 2 * sizeof(uint64_t));
+            if (!grown) break;
+            latencies = grown;
+            capacity *= 2;
+        }
+        latencies[stats->ops++] = elapsed;
+        stats->op_counts[record.op]++;
+        stats->op_nanos[record.op] += elapsed;
+        stats->total_nanos += elapsed;
+    }
+
+    backend->destroy(ctx);
+    fclose(file);
+
+    if (stats->ops > 0) {
+        qsort(latencies, stats->ops, sizeof(uint64_t), cmp_u64);
+        stats->p50_nanos = latencies[stats->ops / 2];
+        stats->p99_nanos = latencies[(stats->ops * 99) / 100];
+        stats->max_nanos = latencies[stats->ops - 1];
+        if (stats->total_nanos > 0) {
+            stats->ops_per_sec = (double)stats->ops * 1e9 / (double)stats->total_nanos;
+        }
+    }
+    free(latencies);
+
+    return true;
+}
+
+const char* list_trace_op_name(TraceOp op) {
+    static const char* names[TRACE_OP_COUNT] = {
+        "insert_at_head", "insert_at_tail", "insert_at_position",
+        "insert_after_node", "insert_before_node",
+        "delete_at_head", "delete_at_tail", "delete_by_value",
+        "delete_at_position", "delete_node",
+        "search_by_value", "search_by_value_reverse",
+        "get_node_at_position", "get_node_at_position_reverse",
+        "update_by_value", "update_node", "update_if", "clear_list",
+        "reverse_list", "sort_list", "copy_list", "clone_list", "compare_lists", "concat_lists",
+        "detach_node", "attach_node_at_head", "attach_node_at_tail", "move_to_head", "move_to_tail",
+        "replace_node_data",
+        "union_lists", "intersect_lists", "difference_lists", "symmetric_difference_lists",
+        "union_lists_inplace", "intersect_lists_inplace", "difference_lists_inplace",
+        "symmetric_difference_lists_inplace", "merge_sorted_lists", "compact_list"
+    };
+    return op < TRACE_OP_COUNT ? names[op] : "unknown";
+}
+
+void list_trace_print_stats(FILE* out, const char* backend_name, const TraceReplayStats* stats) {
+    if (!out || !stats) return;
+
+    fprintf(out, "后端: %s\n", backend_name ? backend_name : "?");
+    fprintf(out, "操作数: %zu, 总耗时: %.4f秒, 吞吐量: %.0f ops/s\n",
+            stats->ops, (double)stats->total_nanos / 1e9, stats->ops_per_sec);
+    fprintf(out, "延迟: P50 %lluns, P99 %lluns, 最大 %lluns\n",
+            (unsigned long long)stats->p50_nanos,
+            (unsigned long long)stats->p99_nanos,
+            (unsigned long long)stats->max_nanos);
+    for (int op = 0; op < TRACE_OP_COUNT; op++) {
+        if (stats->op_counts[op] == 0) continue;
+        fprintf(out, "  %-30s %10zu 次, 平均 %8.0fns\n", list_trace_op_name(op),
+                stats->op_counts[op], (double)stats->op_nanos[op] / stats->op_counts[op]);
+    }
+}
+
+// ==================== 默认 List 后端 ====================
+// 通过节点句柄的操作（insert_after_node / delete_node 等）在跟踪中没有位置，
+// 回放时选取值等于 key_hash 的节点，没有时按 key_hash 取模选取
+
+typedef struct {
+    uint32_t id;
+    List* list;
+} ReplayList;
+
+typedef struct {
+    ReplayList* lists;
+    size_t count;
+    size_t capacity;
+} ReplayContext;
+
+static int replay_cmp(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return x < y ? -1 : (x > y);
+}
+
+static void replay_update(void* data, const void* new_value) {
+    *(int*)data = *(const int*)new_value;
+}
+
+static bool replay_pred(const void* data) {
+    return (*(const int*)data & 1) == 0;
+}
+
+static void* replay_create(void) {
+    return calloc(1, sizeof(ReplayContext));
+}
+
+static void replay_destroy(void* ctx) {
+    ReplayContext* context = ctx;
+    for (size_t i = 0; i < context->count; i++) {
+        destroy_list(context->lists[i].list);
+    }
+    free(context->lists);
+    free(context);
+}
+
+static List* replay_list(ReplayContext* context, uint32_t id) {
+    for (size_t i = 0; i < context->count; i++) {
+        if (context->lists[i].id == id) return context->lists[i].list;
+    }
+
+    if (context->count == context->capacity) {
+        size_t capacity = context->capacity ? context->capacity * 2 : 8;
+        ReplayList* grown = realloc(context->lists, capacity * sizeof(ReplayList));
+        if (!grown) return NULL;
+        context->lists = grown;
+        context->capacity = capacity;
+    }
+
+    List* list = init_list(replay_cmp, free);
+    if (!list) return NULL;
+    context->lists[context->count].id = id;
+    context->lists[context->count].list = list;
+    context->count++;
+    return list;
+}
+
+static void* replay_copy(const void* data) {
+    int* value = malloc(sizeof(int));
+    if (value) *value = *(const int*)data;
+    return value;
+}
+
+static int* replay_value(uint32_t key_hash) {
+    int* value = malloc(sizeof(int));
+    if (value) *value = (int)key_hash;
+    return value;
+}
+
+// 为没有位置信息的节点句柄操作选取节点
+static ListNode* replay_pick(List* list, uint32_t key_hash) {
+    if (list->size == 0) return NULL;
+    int key = (int)key_hash;
+    ListNode* node = search_by_value(list, &key);
+    return node ? node : get_node_at_position(list, (int)(key_hash % list->size));
+}
+
+static void replay_execute(void* ctx, const TraceRecord* record) {
+    List* list = replay_list(ctx, record->list_id);
+    if (!list) return;
+
+    int key = (int)record->key_hash;
+    int size = (int)list->size;
+    ListNode* node;
+    List* other = NULL;
+    if (op_takes_list((TraceOp)record->op)) {
+        other = replay_list(ctx, record->key_hash);
+        if (!other || other == list) return;
+    }
+
+    switch (record->op) {
+    case TRACE_INSERT_HEAD:
+        insert_at_head(list, replay_value(record->key_hash));
+        break;
+    case TRACE_INSERT_TAIL:
+        insert_at_tail(list, replay_value(record->key_hash));
+        break;
+    case TRACE_INSERT_POSITION:
+        insert_at_position(list, replay_value(record->key_hash),
+                           record->position <= size ? record->position : size);
+        break;
+    case TRACE_INSERT_AFTER:
+    case TRACE_INSERT_BEFORE:
+        node = replay_pick(list, record->key_hash);
+        if (!node) {
+            insert_at_tail(list, replay_value(record->key_hash));
+        } else if (record->op == TRACE_INSERT_AFTER) {
+            insert_after_node(list, node, replay_value(record->key_hash));
+        } else {
+            insert_before_node(list, node, replay_value(record->key_hash));
+        }
+        break;
+    case TRACE_DELETE_HEAD:
+        delete_at_head(list);
+        break;
+    case TRACE_DELETE_TAIL:
+        delete_at_tail(list);
+        break;
+    case TRACE_DELETE_VALUE:
+        delete_by_value(list, &key);
+        break;
+    case TRACE_DELETE_POSITION:
+        if (record->position < size) delete_at_position(list, record->position);
+        break;
+    case TRACE_DELETE_NODE:
+        node = replay_pick(list, record->key_hash);
+        if (node) delete_node(list, node);
+        break;
+    case TRACE_SEARCH:
+        search_by_value(list, &key);
+        break;
+    case TRACE_SEARCH_REVERSE:
+        search_by_value_reverse(list, &key);
+        break;
+    case TRACE_GET_POSITION:
+        if (record->position < size) get_node_at_position(list, record->position);
+        break;
+    case TRACE_GET_POSITION_REVERSE:
+        if (record->position < size) get_node_at_position_reverse(list, record->position);
+        break;
+    case TRACE_UPDATE_VALUE:
+        update_by_value(list, &key, &key, replay_update);
+        break;
+    case TRACE_UPDATE_NODE:
+        node = replay_pick(list, record->key_hash);
+        if (node) update_node(list, node, &key, replay_update);
+        break;
+    case TRACE_UPDATE_IF:
+        update_if(list, replay_pred, &key, replay_update);
+        break;
+    case TRACE_CLEAR:
+        clear_list(list);
+        break;
+    case TRACE_REVERSE:
+        reverse_list(list);
+        break;
+    case TRACE_SORT:
+        sort_list(list);
+        break;
+    case TRACE_COPY:
+        copy_list(list, other, replay_copy);
+        break;
+    case TRACE_CLONE:
+        // 副本的标识可能是复用的地址，先清空再复制
+        clear_list(other);
+        copy_list(other, list, replay_copy);
+        break;
+    case TRACE_COMPARE:
+        compare_lists(list, other);
+        break;
+    case TRACE_CONCAT:
+        concat_lists(list, other);
+        break;
+    case TRACE_DETACH_NODE:
+        // 摘下的节点在跟踪中之后按数据重新挂回，这里直接释放
+        node = replay_pick(list, record->key_hash);
+        if (node) delete_node(list, node);
+        break;
+    case TRACE_ATTACH_HEAD:
+        insert_at_head(list, replay_value(record->key_hash));
+        break;
+    case TRACE_ATTACH_TAIL:
+        insert_at_tail(list, replay_value(record->key_hash));
+        break;
+    case TRACE_MOVE_HEAD:
+    case TRACE_MOVE_TAIL:
+        node = replay_pick(list, record->key_hash);
+        if (node && record->op == TRACE_MOVE_HEAD) {
+            move_to_head(list, node);
+        } else if (node) {
+            move_to_tail(list, node);
+        }
+        break;
+    case TRACE_REPLACE_NODE:
+        node = replay_pick(list, record->key_hash);
+        if (node) replace_node_data(list, node, replay_value(record->key_hash));
+        break;
+    case TRACE_UNION:
+        destroy_list(union_lists(list, other));
+        break;
+    case TRACE_INTERSECT:
+        destroy_list(intersect_lists(list, other));
+        break;
+    case TRACE_DIFFERENCE:
+        destroy_list(difference_lists(list, other));
+        break;
+    case TRACE_SYMMETRIC_DIFFERENCE:
+        destroy_list(symmetric_difference_lists(list, other));
+        break;
+    case TRACE_UNION_INPLACE:
+        union_lists_inplace(list, other);
+        break;
+    case TRACE_INTERSECT_INPLACE:
+        intersect_lists_inplace(list, other);
+        break;
+    case TRACE_DIFFERENCE_INPLACE:
+        difference_lists_inplace(list, other);
+        break;
+    case TRACE_SYMMETRIC_DIFFERENCE_INPLACE:
+        symmetric_difference_lists_inplace(list, other);
+        break;
+    case TRACE_MERGE:
+        merge_sorted_lists(list, other);
+        break;
+    case TRACE_COMPACT:
+        if (record->position < 0) {
+            compact_list(list, 0);
+        } else {
+            compact_list_step(list, (size_t)record->position, 0);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+const TraceBackend list_trace_list_backend = {
+    "List", replay_create, replay_execute, replay_destroy
+};
@@ -0,0 +1,211 @@
+#include "lru_cache.h"
+
+#define LRU_INITIAL_BUCKETS 16
+
+static LRUEntry** bucket_of(LRUCache* cache, uint64_t hash) {
+    return &cache->buckets[hash & (cache->bucket_count - 1)];
+}
+
+static LRUEntry* find_entry(LRUCache* cache, const void* key, uint64_t hash) {
+    for (LRUEntry* entry = *bucket_of(cache, hash); entry; entry = entry->chain) {
+        if (entry->hash == hash && cache->key_cmp(entry->key, key) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+// 负载因子超过 3/4 时桶数翻倍
+static bool grow_buckets(LRUCache* cache) {
+    size_t new_count = cache->bucket_count * 2;
+    LRUEntry** new_buckets = calloc(new_count, sizeof(LRUEntry*));
+    if (!new_buckets) return false;
+
+    for (size_t i = 0; i < cache->bucket_count; i++) {
+        LRUEntry* entry = cache->buckets[i];
+        while (entry) {
+            LRUEntry* chain = entry->chain;
+            LRUEntry** bucket = &new_buckets[entry->hash & (new_count - 1)];
+            entry->chain = *bucket;
+            *bucket = entry;
+            entry = chain;
+        }
+    }
+
+    free(cache->buckets);
+    cache->buckets = new_buckets;
+    cache->bucket_count = new_count;
+    return true;
+}
+
+// 从索引和链表中摘除条目并释放
+static void remove_entry(LRUCache* cache, LRUEntry* entry) {
+    LRUEntry** link = bucket_of(cache, entry->hash);
+    while (*link != entry) {
+        link = &(*link)->chain;
+    }
+    *link = entry->chain;
+
+    free_node(detach_node(&cache->list, entry->node));
+    cache->bytes -= entry->bytes;
+
+    if (cache->free_key) cache->free_key(entry->key);
+    if (cache->free_value) cache->free_value(entry->value);
+    free(entry);
+}
+
+static bool over_capacity(LRUCache* cache) {
+    return (cache->max_entries && cache->list.size > cache->max_entries) ||
+           (cache->max_bytes && cache->bytes > cache->max_bytes);
+}
+
+LRUCache* lru_create(hash_fn hash, int (*key_cmp)(const void *, const void *),
+                     void (*free_key)(void *), void (*free_value)(void *),
+                     size_t max_entries, size_t max_bytes) {
+    if (!hash || !key_cmp) return NULL;
+
+    LRUCache* cache = malloc(sizeof(LRUCache));
+    if (!cache) return NULL;
+
+    cache->buckets = calloc(LRU_INITIAL_BUCKETS, sizeof(LRUEntry*));
+    if (!cache->buckets) {
+        free(cache);
+        return NULL;
+    }
+    cache->bucket_count = LRU_INITIAL_BUCKETS;
+
+    init_list_inplace(&cache->list, NULL, NULL);
+
+    cache->max_entries = max_entries;
+    cache->max_bytes = max_bytes;
+    cache->bytes = 0;
+    cache->stats.hits = 0;
+    cache->stats.misses = 0;
+    cache->stats.evictions = 0;
+
+    cache->hash = hash;
+    cache->key_cmp = key_cmp;
+    cache->free_key = free_key;
+    cache->free_value = free_value;
+
+    return cache;
+}
+
+void* lru_get(LRUCache* cache, const void* key) {
+    if (!cache) return NULL;
+
+    LRUEntry* entry = find_entry(cache, key, cache->hash(key));
+    if (!entry) {
+        cache->stats.misses++;
+        return NULL;
+    }
+
+    cache->stats.hits++;
+    move_to_head(&cache->list, entry->node);
+    return entry->value;
+}
+
+void* lru_peek(LRUCache* cache, const void* key) {
+    if (!cache) return NULL;
+
+    LRUEntry* entry = find_entry(cache, key, cache->hash(key));
+    return entry ? entry->value : NULL;
+}
+
+bool lru_put(LRUCache* cache, void* key, void* value, size_t bytes) {
+    if (!cache) return false;
+    if (cache->max_bytes && bytes > cache->max_bytes) return false;
+
+    uint64_t hash = cache->hash(key);
+    LRUEntry* entry = find_entry(cache, key, hash);
+    if (entry) {
+        // 替换已有条目：沿用缓存中的键，释放传入的重复键和旧值；
+        // 传入的就是缓存中的键或值本身时（例如只为更新字节数）不能释放
+        if (cache->free_key && key != entry->key) cache->free_key(key);
+        if (cache->free_value && value != entry->value) cache->free_value(entry->value);
+        entry->value = value;
+        cache->bytes = cache->bytes - entry->bytes + bytes;
+        entry->bytes = bytes;
+        move_to_head(&cache->list, entry->node);
+    } else {
+        if (cache->list.size + 1 > cache->bucket_count / 4 * 3) {
+            grow_buckets(cache);    // 扩容失败时仅增加冲突，不影响正确性
+        }
+
+        entry = malloc(sizeof(LRUEntry));
+        if (!entry) return false;
+
+        entry->node = insert_at_head(&cache->list, entry);
+        if (!entry->node) {
+            free(entry);
+            return false;
+        }
+
+        entry->key = key;
+        entry->value = value;
+        entry->bytes = bytes;
+        entry->hash = hash;
+
+        LRUEntry** bucket = bucket_of(cache, hash);
+        entry->chain = *bucket;
+        *bucket = entry;
+        cache->bytes += bytes;
+    }
+
+    // 淘汰时不会淘汰刚插入的条目：它在头部，且单独不超过容量
+    while (over_capacity(cache)) {
+        lru_evict_tail(cache);
+    }
+
+    return true;
+}
+
+bool lru_remove(LRUCache* cache, const void* key) {
+    if (!cache) return false;
+
+    LRUEntry* entry = find_entry(cache, key, cache->hash(key));
+    if (!entry) return false;
+
+    remove_entry(cache, entry);
+    return true;
+}
+
+bool lru_evict_tail(LRUCache* cache) {
+    if (!cache || !cache->list.tail) return false;
+
+    remove_entry(cache, cache->list.tail->data);
+    cache->stats.evictions++;
+    return true;
+}
+
+size_t lru_size(LRUCache* cache) {
+    if (!cache) return 0;
+    return cache->list.size;
+}
+
+size_t lru_bytes(LRUCache* cache) {
+    if (!cache) return 0;
+    return cache->bytes;
+}
+
+LRUStats lru_stats(LRUCache* cache) {
+    LRUStats empty = {0, 0, 0};
+    if (!cache) return empty;
+    return cache->stats;
+}
+
+void lru_clear(LRUCache* cache) {
+    if (!cache) return;
+
+    while (cache->list.head) {
+        remove_entry(cache, cache->list.head->data);
+    }
+}
+
+void lru_destroy(LRUCache* cache) {
+    if (!cache) return;
+
+    lru_clear(cache);
+    free(cache->buckets);
+    free(cache);
+}
@@ -0,0 +1,453 @@
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include "paged_list.h"
+
+// 页在文件中的格式：每个元素依次为 4 字节长度 + 序列化内容
+
+static bool write_all(int fd, const void* buf, size_t length, long offset) {
+    const unsigned char* p = buf;
+    while (length > 0) {
+        ssize_t written = pwrite(fd, p, length, offset);
+        if (written <= 0) return false;
+        p += written;
+        offset += written;
+        length -= (size_t)written;
+    }
+    return true;
+}
+
+static bool read_all(int fd, void* buf, size_t length, long offset) {
+    unsigned char* p = buf;
+    while (length > 0) {
+        ssize_t got = pread(fd, p, length, offset);
+        if (got <= 0) return false;
+        p += got;
+        offset += got;
+        length -= (size_t)got;
+    }
+    return true;
+}
+
+static bool reserve_buffer(PagedList* list, size_t size) {
+    if (size <= list->buffer_size) return true;
+
+    size_t new_size = list->buffer_size ? list->buffer_size : 4096;
+    while (new_size < size) {
+        new_size *= 2;
+    }
+    unsigned char* buffer = realloc(list->buffer, new_size);
+    if (!buffer) return false;
+
+    list->buffer = buffer;
+    list->buffer_size = new_size;
+    return true;
+}
+
+// 把页序列化到缓冲区，返回总字节数，失败返回 0 且 ok 为 false
+static size_t serialize_page(PagedList* list, Page* page, bool* ok) {
+    size_t used = 0;
+    *ok = false;
+
+    for (size_t i = 0; i < page->count; i++) {
+        for (;;) {
+            size_t room = list->buffer_size > used + 4 ? list->buffer_size - used - 4 : 0;
+            size_t length = list->serialize(page->items[i], list->buffer + used + 4, room);
+            if (length <= room) {
+                uint32_t header = (uint32_t)length;
+                memcpy(list->buffer + used, &header, 4);
+                used += 4 + length;
+                break;
+            }
+            if (!reserve_buffer(list, used + 4 + length)) return 0;
+        }
+    }
+
+    *ok = true;
+    return used;
+}
+
+// ==================== 文件空间 ====================
+
+// 把 [offset, offset + length) 还给空闲区间表：按偏移插入并与相邻区间合并，到达文件末尾时截短文件
+static void release_extent(PagedList* list, long offset, size_t length) {
+    if (length == 0) return;
+
+    ListNode* next = list->extents.head;
+    while (next && ((Extent*)next->data)->offset < offset) {
+        next = next->next;
+    }
+    ListNode* prev = next ? next->prev : list->extents.tail;
+    Extent* before = prev ? prev->data : NULL;
+    Extent* after = next ? next->data : NULL;
+
+    if (before && before->offset + (long)before->length == offset) {
+        before->length += length;
+        if (after && offset + (long)length == after->offset) {
+            before->length += after->length;
+            delete_node(&list->extents, next);
+        }
+    } else if (after && offset + (long)length == after->offset) {
+        after->offset = offset;
+        after->length += length;
+    } else {
+        // 记账失败只是少复用一段空间
+        Extent* extent = malloc(sizeof(Extent));
+        if (!extent) return;
+        extent->offset = offset;
+        extent->length = length;
+        ListNode* node = prev ? insert_after_node(&list->extents, prev, extent)
+                              : insert_at_head(&list->extents, extent);
+        if (!node) {
+            free(extent);
+            return;
+        }
+    }
+
+    // 截短失败时区间留在表中照常复用
+    Extent* last = list->extents.tail->data;
+    if (last->offset + (long)last->length == list->file_end && ftruncate(list->fd, last->offset) == 0) {
+        list->file_end = last->offset;
+        delete_node(&list->extents, list->extents.tail);
+    }
+}
+
+// 为 length 字节找位置：取第一个放得下的空闲区间（剩余部分留在表中），没有时追加到文件末尾
+static long allocate_extent(PagedList* list, size_t length) {
+    for (ListNode* node = list->extents.head; node; node = node->next) {
+        Extent* extent = node->data;
+        if (extent->length >= length) {
+            long offset = extent->offset;
+            extent->offset += (long)length;
+            extent->length -= length;
+            if (extent->length == 0) delete_node(&list->extents, node);
+            return offset;
+        }
+    }
+
+    long offset = list->file_end;
+    list->file_end += (long)length;
+    return offset;
+}
+
+// ==================== 换入 / 换出 ====================
+
+// 换出：必要时写回文件，然后释放内存中的元素
+static bool page_out(PagedList* list, Page* page) {
+    if (page->dirty || page->offset < 0) {
+        bool ok;
+        size_t length = serialize_page(list, page, &ok);
+        if (!ok) return false;
+
+        // 原位置放得下就覆盖，否则归还原位置，另找空闲区间或追加到文件末尾
+        if (page->offset < 0 || length > page->reserved) {
+            if (page->offset >= 0) release_extent(list, page->offset, page->reserved);
+            page->offset = allocate_extent(list, length);
+            page->reserved = length;
+        }
+        if (length > 0 && !write_all(list->fd, list->buffer, length, page->offset)) {
+            return false;
+        }
+        page->stored = length;
+        page->dirty = false;
+        list->page_outs++;
+    }
+
+    for (size_t i = 0; i < page->count; i++) {
+        if (list->free_data) list->free_data(page->items[i]);
+    }
+    free(page->items);
+    page->items = NULL;
+
+    free_node(detach_node(&list->hot, page->hot));
+    page->hot = NULL;
+    return true;
+}
+
+// 保证热页数量低于上限，给即将换入的页腾出位置
+static bool make_room(PagedList* list) {
+    while (list->hot.size >= list->max_hot_pages) {
+        if (!page_out(list, list->hot.tail->data)) return false;
+    }
+    return true;
+}
+
+// 提示内核预读下一页
+static void read_ahead(PagedList* list, ListNode* node) {
+    if (!node) return;
+    Page* page = node->data;
+    if (!page->items && page->offset >= 0 && page->stored > 0) {
+        posix_fadvise(list->fd, page->offset, (off_t)page->stored, POSIX_FADV_WILLNEED);
+    }
+}
+
+// 换入页并标记为最近使用
+static bool page_in(PagedList* list, Page* page) {
+    if (page->items) {
+        move_to_head(&list->hot, page->hot);
+        return true;
+    }
+
+    if (!make_room(list)) return false;
+
+    void** items = malloc(list->page_capacity * sizeof(void*));
+    if (!items) return false;
+
+    if (page->stored > 0) {
+        if (!reserve_buffer(list, page->stored) ||
+            !read_all(list->fd, list->buffer, page->stored, page->offset)) {
+            free(items);
+            return false;
+        }
+
+        size_t used = 0;
+        for (size_t i = 0; i < page->count; i++) {
+            uint32_t length;
+            memcpy(&length, list->buffer + used, 4);
+            items[i] = list->deserialize(list->buffer + used + 4, length);
+            used += 4 + length;
+        }
+    }
+
+    page->hot = insert_at_head(&list->hot, page);
+    if (!page->hot) {
+        for (size_t i = 0; i < page->count; i++) {
+            if (list->free_data) list->free_data(items[i]);
+        }
+        free(items);
+        return false;
+    }
+
+    page->items = items;
+    list->page_ins++;
+    return true;
+}
+
+static Page* new_page(PagedList* list, bool at_head) {
+    if (!make_room(list)) return NULL;
+
+    Page* page = calloc(1, sizeof(Page));
+    if (!page) return NULL;
+
+    page->items = malloc(list->page_capacity * sizeof(void*));
+    page->offset = -1;
+    page->dirty = true;
+    page->node = at_head ? insert_at_head(&list->pages, page) : insert_at_tail(&list->pages, page);
+    page->hot = insert_at_head(&list->hot, page);
+    if (!page->items || !page->node || !page->hot) {
+        if (page->node) free_node(detach_node(&list->pages, page->node));
+        if (page->hot) free_node(detach_node(&list->hot, page->hot));
+        free(page->items);
+        free(page);
+        return NULL;
+    }
+
+    return page;
+}
+
+// 删除已空的页，文件中的空间归还空闲区间表
+static void drop_page(PagedList* list, Page* page) {
+    if (page->offset >= 0) release_extent(list, page->offset, page->reserved);
+    if (page->hot) free_node(detach_node(&list->hot, page->hot));
+    free_node(detach_node(&list->pages, page->node));
+    free(page->items);
+    free(page);
+}
+
+PagedList* paged_list_create(const char* path, size_t page_capacity, size_t max_hot_pages,
+                             serialize_fn serialize, deserialize_fn deserialize,
+                             void (*free_data)(void *)) {
+    if (!path || page_capacity == 0 || max_hot_pages == 0 || !serialize || !deserialize) {
+        return NULL;
+    }
+
+    PagedList* list = calloc(1, sizeof(PagedList));
+    if (!list) return NULL;
+
+    list->path = malloc(strlen(path) + 1);
+    if (!list->path) {
+        free(list);
+        return NULL;
+    }
+    strcpy(list->path, path);
+
+    if (!reserve_buffer(list, 4096)) {
+        free(list->path);
+        free(list);
+        return NULL;
+    }
+
+    list->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (list->fd < 0) {
+        fprintf(stderr, "Error: Cannot open spill file %s\n", path);
+        free(list->buffer);
+        free(list->path);
+        free(list);
+        return NULL;
+    }
+
+    init_list_inplace(&list->pages, NULL, NULL);
+    init_list_inplace(&list->hot, NULL, NULL);
+    init_list_inplace(&list->extents, NULL, free);
+    list->page_capacity = page_capacity;
+    list->max_hot_pages = max_hot_pages;
+    list->serialize = serialize;
+    list->deserialize = deserialize;
+    list->free_data = free_data;
+
+    return list;
+}
+
+bool paged_list_push_back(PagedList* list, void* data) {
+    if (!list) return false;
+
+    Page* page = list->pages.tail ? list->pages.tail->data : NULL;
+    if (!page || page->count == list->page_capacity) {
+        page = new_page(list, false);
+    } else if (!page_in(list, page)) {
+        return false;
+    }
+    if (!page) return false;
+
+    page->items[page->count++] = data;
+    page->dirty = true;
+    list->size++;
+    return true;
+}
+
+bool paged_list_push_front(PagedList* list, void* data) {
+    if (!list) return false;
+
+    Page* page = list->pages.head ? list->pages.head->data : NULL;
+    if (!page || page->count == list->page_capacity) {
+        page = new_page(list, true);
+    } else if (!page_in(list, page)) {
+        return false;
+    }
+    if (!page) return false;
+
+    memmove(page->items + 1, page->items, page->count * sizeof(void*));
+    page->items[0] = data;
+    page->count++;
+    page->dirty = true;
+    list->size++;
+    return true;
+}
+
+void* paged_list_pop_front(PagedList* list) {
+    if (!list || !list->pages.head) return NULL;
+
+    Page* page = list->pages.head->data;
+    if (!page_in(list, page)) return NULL;
+
+    void* data = page->items[0];
+    page->count--;
+    memmove(page->items, page->items + 1, page->count * sizeof(void*));
+    page->dirty = true;
+    list->size--;
+
+    if (page->count == 0) {
+        drop_page(list, page);
+    }
+    return data;
+}
+
+void* paged_list_pop_back(PagedList* list) {
+    if (!list || !list->pages.tail) return NULL;
+
+    Page* page = list->pages.tail->data;
+    if (!page_in(list, page)) return NULL;
+
+    void* data = page->items[--page->count];
+    page->dirty = true;
+    list->size--;
+
+    if (page->count == 0) {
+        drop_page(list, page);
+    }
+    return data;
+}
+
+void* paged_list_get(PagedList* list, size_t index) {
+    if (!list || index >= list->size) return NULL;
+
+    // 从离目标更近的一端开始数页
+    if (index < list->size / 2) {
+        for (ListNode* node = list->pages.head; node; node = node->next) {
+            Page* page = node->data;
+            if (index < page->count) {
+                return page_in(list, page) ? page->items[index] : NULL;
+            }
+            index -= page->count;
+        }
+    } else {
+        size_t from_end = list->size - 1 - index;
+        for (ListNode* node = list->pages.tail; node; node = node->prev) {
+            Page* page = node->data;
+            if (from_end < page->count) {
+                return page_in(list, page) ? page->items[page->count - 1 - from_end] : NULL;
+            }
+            from_end -= page->count;
+        }
+    }
+    return NULL;
+}
+
+PagedIterator paged_list_begin(PagedList* list) {
+    PagedIterator it = {list, list ? list->pages.head : NULL, 0};
+    return it;
+}
+
+void* paged_list_next(PagedIterator* it) {
+    if (!it || !it->list) return NULL;
+
+    while (it->page) {
+        Page* page = it->page->data;
+        if (it->index < page->count) {
+            if (it->index == 0) {
+                if (!page_in(it->list, page)) return NULL;
+                read_ahead(it->list, it->page->next);
+            } else if (!page->items && !page_in(it->list, page)) {
+                return NULL;
+            }
+            return page->items[it->index++];
+        }
+        it->page = it->page->next;
+        it->index = 0;
+    }
+    return NULL;
+}
+
+size_t paged_list_size(PagedList* list) {
+    if (!list) return 0;
+    return list->size;
+}
+
+size_t paged_list_hot_pages(PagedList* list) {
+    if (!list) return 0;
+    return list->hot.size;
+}
+
+void paged_list_destroy(PagedList* list) {
+    if (!list) return;
+
+    ListNode* node = list->pages.head;
+    while (node) {
+        ListNode* next = node->next;
+        Page* page = node->data;
+        if (page->items) {
+            for (size_t i = 0; i < page->count; i++) {
+                if (list->free_data) list->free_data(page->items[i]);
+            }
+        }
+        drop_page(list, page);
+        node = next;
+    }
+    clear_list(&list->extents);
+
+    close(list->fd);
+    unlink(list->path);
+    free(list->path);
+    free(list->buffer);
+    free(list);
+}
@@ -0,0 +1,117 @@
+#include <stdatomic.h>
+#include "sharded_list.h"
+
+// 每个线程第一次访问时分配一个全局递增的序号，按序号映射到分片
+static atomic_size_t thread_counter = 0;
+static __thread size_t thread_slot = SIZE_MAX;
+
+static size_t current_thread_slot(void) {
+    if (thread_slot == SIZE_MAX) {
+        thread_slot = atomic_fetch_add(&thread_counter, 1);
+    }
+    return thread_slot;
+}
+
+ShardedList* sharded_list_create(size_t shard_count,
+                                 int (*cmp)(const void *, const void *),
+                                 void (*free_data)(void *)) {
+    if (shard_count == 0) return NULL;
+
+    ShardedList* list = malloc(sizeof(ShardedList));
+    if (!list) return NULL;
+
+    list->shards = aligned_alloc(SHARD_CACHE_LINE, shard_count * sizeof(ListShard));
+    if (!list->shards) {
+        free(list);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < shard_count; i++) {
+        pthread_mutex_init(&list->shards[i].lock, NULL);
+        init_list_inplace(&list->shards[i].list, cmp, free_data);
+    }
+    list->shard_count = shard_count;
+    list->cmp = cmp;
+    list->free_data = free_data;
+
+    return list;
+}
+
+ListShard* sharded_list_local(ShardedList* list) {
+    if (!list) return NULL;
+    return &list->shards[current_thread_slot() % list->shard_count];
+}
+
+ListNode* sharded_list_insert(ShardedList* list, void* data) {
+    ListShard* shard = sharded_list_local(list);
+    if (!shard) return NULL;
+
+    pthread_mutex_lock(&shard->lock);
+    ListNode* node = insert_at_tail(&shard->list, data);
+    pthread_mutex_unlock(&shard->lock);
+
+    return node;
+}
+
+size_t sharded_list_size(ShardedList* list) {
+    if (!list) return 0;
+
+    size_t total = 0;
+    for (size_t i = 0; i < list->shard_count; i++) {
+        pthread_mutex_lock(&list->shards[i].lock);
+        total += get_length(&list->shards[i].list);
+        pthread_mutex_unlock(&list->shards[i].lock);
+    }
+    return total;
+}
+
+void sharded_list_for_each(ShardedList* list, void (*fn)(void *data, void *ctx), void* ctx) {
+    if (!list || !fn) return;
+
+    for (size_t i = 0; i < list->shard_count; i++) {
+        ListShard* shard = &list->shards[i];
+        pthread_mutex_lock(&shard->lock);
+        for (ListNode* node = get_first_node(&shard->list); node; node = get_next_node(&shard->list, node)) {
+            fn(node->data, ctx);
+        }
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
+
+void* sharded_list_search(ShardedList* list, const void* key) {
+    if (!list || !list->cmp) return NULL;
+
+    for (size_t i = 0; i < list->shard_count; i++) {
+        ListShard* shard = &list->shards[i];
+        pthread_mutex_lock(&shard->lock);
+        ListNode* node = search_by_value(&shard->list, (void*)key);
+        void* data = node ? node->data : NULL;
+        pthread_mutex_unlock(&shard->lock);
+
+        if (data) return data;
+    }
+    return NULL;
+}
+
+bool sharded_list_collect(ShardedList* list, List* dest) {
+    if (!list || !dest) return false;
+
+    for (size_t i = 0; i < list->shard_count; i++) {
+        ListShard* shard = &list->shards[i];
+        pthread_mutex_lock(&shard->lock);
+        concat_lists(dest, &shard->list);
+        pthread_mutex_unlock(&shard->lock);
+    }
+    return true;
+}
+
+void sharded_list_destroy(ShardedList* list) {
+    if (!list) return;
+
+    for (size_t i = 0; i < list->shard_count; i++) {
+        clear_list(&list->shards[i].list);
+        pthread_mutex_destroy(&list->shards[i].lock);
+    }
+    free(list->shards);
+    free(list);
+}
@@ -0,0 +1,385 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdalign.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "shm_list.h"
+
+#define SHM_LIST_MAGIC 0x4c53484d4c495354ULL    // "LSHMLIST"
+#define SHM_ALIGN alignof(max_align_t)
+#define SHM_ROUND(n) (((n) + SHM_ALIGN - 1) / SHM_ALIGN * SHM_ALIGN)
+#define SHM_NODE_SPACE SHM_ROUND(sizeof(ShmNode))
+
+// ==================== 偏移与指针转换 ====================
+// 段内只保存偏移，每次访问按本进程的映射地址换算
+
+static ShmNode* node_at(ShmListHeader* header, shm_off_t offset) {
+    return offset ? (ShmNode*)((char*)header + offset) : NULL;
+}
+
+static shm_off_t offset_of(ShmListHeader* header, ShmNode* node) {
+    return node ? (shm_off_t)((char*)node - (char*)header) : 0;
+}
+
+// 让链表中其他进程可见的链接以 release 语义写入：编译器和 CPU 都不会把它之前的写入
+// （新节点自身的字段、数据）挪到它之后，持锁进程崩溃后 repair 看到的 next 链总是完整的
+static void publish(shm_off_t* link, shm_off_t offset) {
+    __atomic_store_n(link, offset, __ATOMIC_RELEASE);
+}
+
+// ==================== 段内分配器 ====================
+// 优先复用空闲链表中的槽位，否则从未用区域切出下一个槽位（未用区域保持为 ftruncate 的零页，不预先触碰）
+
+static ShmNode* slot_alloc(ShmListHeader* header) {
+    ShmNode* node = node_at(header, header->free_slots);
+    if (node) {
+        header->free_slots = node->next;
+    } else if (header->carved < header->capacity) {
+        node = node_at(header, header->slots + header->carved * header->slot_size);
+        header->carved++;
+    } else {
+        return NULL;
+    }
+
+    node->prev = 0;
+    node->next = 0;
+    node->length = 0;
+    return node;
+}
+
+static void slot_free(ShmListHeader* header, ShmNode* node) {
+    node->prev = 0;
+    // 节点刚从链表摘下时，先确保摘除已写入，再把 next 改为空闲链表
+    publish(&node->next, header->free_slots);
+    header->free_slots = offset_of(header, node);
+}
+
+// ==================== 链接 ====================
+// 先写好新节点自身，再修改链表中已可见的 next 链接：任何时刻崩溃，从 head 沿 next 都能走完整个链表
+
+static void link_between(ShmListHeader* header, ShmNode* prev, ShmNode* node, ShmNode* next) {
+    shm_off_t offset = offset_of(header, node);
+    node->prev = offset_of(header, prev);
+    node->next = offset_of(header, next);
+
+    if (prev) {
+        publish(&prev->next, offset);
+    } else {
+        publish(&header->head, offset);
+    }
+    if (next) {
+        next->prev = offset;
+    } else {
+        header->tail = offset;
+    }
+    header->size++;
+}
+
+static void unlink_from(ShmListHeader* header, ShmNode* node) {
+    ShmNode* prev = node_at(header, node->prev);
+    ShmNode* next = node_at(header, node->next);
+
+    if (prev) {
+        publish(&prev->next, node->next);
+    } else {
+        publish(&header->head, node->next);
+    }
+    if (next) {
+        next->prev = node->prev;
+    } else {
+        header->tail = node->prev;
+    }
+    header->size--;
+}
+
+// 持锁进程崩溃后按 next 链重建 prev / tail / size；中途被打断的插入或删除可能泄漏一个槽位
+static void repair(ShmListHeader* header) {
+    ShmNode* prev = NULL;
+    size_t count = 0;
+    for (ShmNode* node = node_at(header, header->head); node && count < header->capacity;
+         node = node_at(header, node->next)) {
+        node->prev = offset_of(header, prev);
+        prev = node;
+        count++;
+    }
+    if (prev) prev->next = 0;
+    header->tail = offset_of(header, prev);
+    header->size = count;
+}
+
+// ==================== 创建 / 挂接 ====================
+
+static ShmList* map_segment(const char* name, int fd, size_t segment_size) {
+    ShmList* list = malloc(sizeof(ShmList));
+    char* copy = strdup(name);
+    void* base = mmap(NULL, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (!list || !copy || base == MAP_FAILED) {
+        if (base != MAP_FAILED) munmap(base, segment_size);
+        free(copy);
+        free(list);
+        return NULL;
+    }
+
+    list->header = base;
+    list->name = copy;
+    return list;
+}
+
+ShmList* shm_list_create(const char* name, size_t capacity, size_t payload_size) {
+    if (!name || capacity == 0) return NULL;
+
+    size_t slot_size = SHM_NODE_SPACE + SHM_ROUND(payload_size);
+    size_t slots = SHM_ROUND(sizeof(ShmListHeader));
+    if (capacity > (SIZE_MAX - slots) / slot_size) return NULL;
+    size_t segment_size = slots + capacity * slot_size;
+
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) return NULL;
+
+    ShmList* list = NULL;
+    if (ftruncate(fd, (off_t)segment_size) == 0) {
+        list = map_segment(name, fd, segment_size);
+    }
+    close(fd);
+    if (!list) {
+        shm_unlink(name);
+        return NULL;
+    }
+
+    ShmListHeader* header = list->header;
+    header->segment_size = segment_size;
+    header->head = 0;
+    header->tail = 0;
+    header->size = 0;
+    header->payload_size = payload_size;
+    header->slot_size = slot_size;
+    header->capacity = capacity;
+    header->carved = 0;
+    header->free_slots = 0;
+    header->slots = slots;
+
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&header->lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    // 最后写入标识：挂接者看到标识时表头已初始化完成
+    __atomic_store_n(&header->magic, SHM_LIST_MAGIC, __ATOMIC_RELEASE);
+
+    return list;
+}
+
+ShmList* shm_list_attach(const char* name) {
+    if (!name) return NULL;
+
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    ShmList* list = NULL;
+    if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(ShmListHeader)) {
+        list = map_segment(name, fd, (size_t)st.st_size);
+    }
+    close(fd);
+    if (!list) return NULL;
+
+    ShmListHeader* header = list->header;
+    if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != SHM_LIST_MAGIC ||
+        header->segment_size != (size_t)st.st_size) {
+        shm_list_detach(list);
+        return NULL;
+    }
+    return list;
+}
+
+void shm_list_detach(ShmList* list) {
+    if (!list) return;
+
+    munmap(list->header, list->header->segment_size);
+    free(list->name);
+    free(list);
+}
+
+void shm_list_destroy(ShmList* list) {
+    if (!list) return;
+
+    shm_unlink(list->name);
+    shm_list_detach(list);
+}
+
+// ==================== 加锁 ====================
+
+bool shm_list_lock(ShmList* list) {
+    if (!list) return false;
+
+    ShmListHeader* header = list->header;
+    int result = pthread_mutex_lock(&header->lock);
+    if (result == EOWNERDEAD) {
+        repair(header);
+        pthread_mutex_consistent(&header->lock);
+        result = 0;
+    }
+    return result == 0;
+}
+
+void shm_list_unlock(ShmList* list) {
+    if (!list) return;
+    pthread_mutex_unlock(&list->header->lock);
+}
+
+// ==================== 插入 / 删除 ====================
+
+ShmNode* shm_list_alloc(ShmList* list, size_t length) {
+    if (!list || length > list->header->payload_size) return NULL;
+    if (!shm_list_lock(list)) return NULL;
+
+    ShmNode* node = slot_alloc(list->header);
+    if (node) node->length = length;
+
+    shm_list_unlock(list);
+    return node;
+}
+
+void shm_list_free(ShmList* list, ShmNode* node) {
+    if (!list || !node) return;
+    if (!shm_list_lock(list)) return;
+
+    slot_free(list->header, node);
+
+    shm_list_unlock(list);
+}
+
+bool shm_list_attach_tail(ShmList* list, ShmNode* node) {
+    if (!list || !node) return false;
+    if (!shm_list_lock(list)) return false;
+
+    ShmListHeader* header = list->header;
+    link_between(header, node_at(header, header->tail), node, NULL);
+
+    shm_list_unlock(list);
+    return true;
+}
+
+bool shm_list_attach_head(ShmList* list, ShmNode* node) {
+    if (!list || !node) return false;
+    if (!shm_list_lock(list)) return false;
+
+    ShmListHeader* header = list->header;
+    link_between(header, NULL, node, node_at(header, header->head));
+
+    shm_list_unlock(list);
+    return true;
+}
+
+ShmNode* shm_list_insert_tail(ShmList* list, const void* data, size_t length) {
+    if (!list || (length && !data)) return NULL;
+    if (!shm_list_lock(list)) return NULL;
+
+    ShmNode* node = shm_list_alloc(list, length);
+    if (node) {
+        if (length) memcpy(shm_node_data(node), data, length);
+        shm_list_attach_tail(list, node);
+    }
+
+    shm_list_unlock(list);
+    return node;
+}
+
+ShmNode* shm_list_insert_head(ShmList* list, const void* data, size_t length) {
+    if (!list || (length && !data)) return NULL;
+    if (!shm_list_lock(list)) return NULL;
+
+    ShmNode* node = shm_list_alloc(list, length);
+    if (node) {
+        if (length) memcpy(shm_node_data(node), data, length);
+        shm_list_attach_head(list, node);
+    }
+
+    shm_list_unlock(list);
+    return node;
+}
+
+bool shm_list_delete(ShmList* list, ShmNode* node) {
+    if (!list || !node) return false;
+    if (!shm_list_lock(list)) return false;
+
+    unlink_from(list->header, node);
+    slot_free(list->header, node);
+
+    shm_list_unlock(list);
+    return true;
+}
+
+size_t shm_list_pop_head(ShmList* list, void* buf, size_t capacity) {
+    if (!list) return 0;
+    if (!shm_list_lock(list)) return 0;
+
+    size_t length = 0;
+    ShmNode* node = node_at(list->header, list->header->head);
+    if (node) {
+        length = node->length;
+        if (buf) memcpy(buf, shm_node_data(node), length < capacity ? length : capacity);
+        shm_list_delete(list, node);
+    }
+
+    shm_list_unlock(list);
+    return length;
+}
+
+// ==================== 遍历 ====================
+
+ShmNode* shm_list_first(ShmList* list) {
+    return list ? node_at(list->header, list->header->head) : NULL;
+}
+
+ShmNode* shm_list_last(ShmList* list) {
+    return list ? node_at(list->header, list->header->tail) : NULL;
+}
+
+ShmNode* shm_list_next(ShmList* list, ShmNode* node) {
+    return list && node ? node_at(list->header, node->next) : NULL;
+}
+
+ShmNode* shm_list_prev(ShmList* list, ShmNode* node) {
+    return list && node ? node_at(list->header, node->prev) : NULL;
+}
+
+void* shm_node_data(ShmNode* node) {
+    return node ? (char*)node + SHM_NODE_SPACE : NULL;
+}
+
+ShmNode* shm_list_search(ShmList* list, const void* key, int (*cmp)(const void *, const void *)) {
+    if (!list || !cmp) return NULL;
+
+    for (ShmNode* node = shm_list_first(list); node; node = shm_list_next(list, node)) {
+        if (cmp(shm_node_data(node), key) == 0) return node;
+    }
+    return NULL;
+}
+
+size_t shm_list_size(ShmList* list) {
+    if (!list || !shm_list_lock(list)) return 0;
+
+    size_t size = list->header->size;
+
+    shm_list_unlock(list);
+    return size;
+}
+
+size_t shm_list_free_slots(ShmList* list) {
+    if (!list || !shm_list_lock(list)) return 0;
+
+    ShmListHeader* header = list->header;
+    size_t count = header->capacity - header->carved;
+    for (ShmNode* node = node_at(header, header->free_slots); node; node = node_at(header, node->next)) {
+        count++;
+    }
+
+    shm_list_unlock(list);
+    return count;
+}
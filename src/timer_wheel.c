@@ -0,0 +1,216 @@
+#include "timer_wheel.h"
+
+#define TW_ROOT_MASK  (TW_ROOT_SIZE - 1)
+#define TW_LEVEL_MASK (TW_LEVEL_SIZE - 1)
+
+// 槽位链表的 free_data：释放定时器本身以及它携带的用户数据
+static void timer_entry_free(void* data) {
+    Timer* timer = data;
+    if (timer->wheel->free_data) {
+        timer->wheel->free_data(timer->data);
+    }
+    free(timer);
+}
+
+static void slot_init(List* slot) {
+    init_list_inplace(slot, NULL, timer_entry_free);
+}
+
+// 根据到期时刻与当前 tick 的距离选择槽位
+static List* slot_for(TimerWheel* wheel, uint64_t expires) {
+    if (expires < wheel->current) {
+        // 已经过期：放入当前槽，下一次推进时立即到期
+        return &wheel->root[wheel->current & TW_ROOT_MASK];
+    }
+
+    uint64_t delta = expires - wheel->current;
+    if (delta < TW_ROOT_SIZE) {
+        return &wheel->root[expires & TW_ROOT_MASK];
+    }
+
+    if (delta > TW_MAX_DELTA) {
+        // 超出时间轮范围：先放在最高层的最远槽位，下放时再按真实到期时刻重新定位
+        expires = wheel->current + TW_MAX_DELTA;
+        delta = TW_MAX_DELTA;
+    }
+
+    for (int level = 0; level < TW_LEVELS; level++) {
+        int shift = TW_ROOT_BITS + level * TW_LEVEL_BITS;
+        if (delta < ((uint64_t)1 << (shift + TW_LEVEL_BITS))) {
+            return &wheel->levels[level][(expires >> shift) & TW_LEVEL_MASK];
+        }
+    }
+
+    return NULL;    // 不可达
+}
+
+// 槽位所在的层：0 为第 0 层，1~TW_LEVELS 为 levels[0~TW_LEVELS-1]
+static int slot_level(TimerWheel* wheel, List* slot) {
+    if (slot >= wheel->root && slot < wheel->root + TW_ROOT_SIZE) {
+        return 0;
+    }
+    return (int)((slot - &wheel->levels[0][0]) / TW_LEVEL_SIZE) + 1;
+}
+
+static void place_timer(TimerWheel* wheel, Timer* timer) {
+    timer->slot = slot_for(wheel, timer->expires);
+    attach_node_at_tail(timer->slot, timer->node);
+    wheel->level_count[slot_level(wheel, timer->slot)]++;
+}
+
+static ListNode* unplace_timer(TimerWheel* wheel, Timer* timer) {
+    wheel->level_count[slot_level(wheel, timer->slot)]--;
+    return detach_node(timer->slot, timer->node);
+}
+
+// 把某一层某个槽位里的定时器全部按当前 tick 重新定位（落入更低层）
+static int cascade(TimerWheel* wheel, int level, int index) {
+    List* slot = &wheel->levels[level][index];
+    while (slot->head) {
+        Timer* timer = slot->head->data;
+        unplace_timer(wheel, timer);
+        place_timer(wheel, timer);
+    }
+    return index;
+}
+
+TimerWheel* timer_wheel_create(uint64_t now, void (*free_data)(void *)) {
+    TimerWheel* wheel = malloc(sizeof(TimerWheel));
+    if (!wheel) return NULL;
+
+    wheel->current = now;
+    wheel->count = 0;
+    for (int level = 0; level <= TW_LEVELS; level++) {
+        wheel->level_count[level] = 0;
+    }
+    wheel->free_data = free_data;
+
+    for (int i = 0; i < TW_ROOT_SIZE; i++) {
+        slot_init(&wheel->root[i]);
+    }
+    for (int level = 0; level < TW_LEVELS; level++) {
+        for (int i = 0; i < TW_LEVEL_SIZE; i++) {
+            slot_init(&wheel->levels[level][i]);
+        }
+    }
+
+    return wheel;
+}
+
+Timer* timer_wheel_schedule(TimerWheel* wheel, uint64_t expires, void* data) {
+    if (!wheel) return NULL;
+
+    Timer* timer = malloc(sizeof(Timer));
+    if (!timer) return NULL;
+
+    timer->node = create_node(timer);
+    if (!timer->node) {
+        free(timer);
+        return NULL;
+    }
+
+    timer->expires = expires;
+    timer->data = data;
+    timer->wheel = wheel;
+    place_timer(wheel, timer);
+    wheel->count++;
+
+    return timer;
+}
+
+bool timer_wheel_reschedule(TimerWheel* wheel, Timer* timer, uint64_t expires) {
+    if (!wheel || !timer || timer->wheel != wheel) return false;
+
+    unplace_timer(wheel, timer);
+    timer->expires = expires;
+    place_timer(wheel, timer);
+
+    return true;
+}
+
+bool timer_wheel_cancel(TimerWheel* wheel, Timer* timer) {
+    if (!wheel || !timer || timer->wheel != wheel) return false;
+
+    List* slot = timer->slot;
+    if (!delete_node(slot, timer->node)) return false;
+    wheel->level_count[slot_level(wheel, slot)]--;
+    wheel->count--;
+
+    return true;
+}
+
+size_t timer_wheel_advance(TimerWheel* wheel, uint64_t now, List* expired) {
+    if (!wheel || !expired) return 0;
+
+    // 保留 UINT64_MAX，下面的 now + 1 不会回绕
+    if (now == UINT64_MAX) now--;
+
+    size_t fired = 0;
+    while (wheel->current <= now) {
+        if (wheel->count == 0) {
+            // 没有挂起的定时器，直接跳到 now 之后
+            wheel->current = now + 1;
+            break;
+        }
+
+        if (wheel->level_count[0] == 0 && (wheel->current & TW_ROOT_MASK) != 0) {
+            // 第 0 层为空：直接跳到最低非空层的下一次下放时刻，中间的 tick 都不会有定时器到期
+            int level = 1;
+            while (wheel->level_count[level] == 0) {
+                level++;
+            }
+            int shift = TW_ROOT_BITS + (level - 1) * TW_LEVEL_BITS;
+            uint64_t next = ((wheel->current >> shift) + 1) << shift;
+            wheel->current = next > wheel->current && next <= now ? next : now + 1;
+            continue;
+        }
+
+        int index = wheel->current & TW_ROOT_MASK;
+        if (index == 0) {
+            // 第 0 层转完一圈，逐层下放；某层下放的槽位号不为 0 时更高层无需处理
+            for (int level = 0; level < TW_LEVELS; level++) {
+                int shift = TW_ROOT_BITS + level * TW_LEVEL_BITS;
+                if (cascade(wheel, level, (wheel->current >> shift) & TW_LEVEL_MASK) != 0) {
+                    break;
+                }
+            }
+        }
+
+        List* slot = &wheel->root[index];
+        while (slot->head) {
+            Timer* timer = slot->head->data;
+            ListNode* node = unplace_timer(wheel, timer);
+
+            // 复用节点：数据所有权交给 expired，定时器本身释放
+            node->data = timer->data;
+            free(timer);
+            attach_node_at_tail(expired, node);
+
+            wheel->count--;
+            fired++;
+        }
+
+        wheel->current++;
+    }
+
+    return fired;
+}
+
+size_t timer_wheel_pending(TimerWheel* wheel) {
+    if (!wheel) return 0;
+    return wheel->count;
+}
+
+void timer_wheel_destroy(TimerWheel* wheel) {
+    if (!wheel) return;
+
+    for (int i = 0; i < TW_ROOT_SIZE; i++) {
+        clear_list(&wheel->root[i]);
+    }
+    for (int level = 0; level < TW_LEVELS; level++) {
+        for (int i = 0; i < TW_LEVEL_SIZE; i++) {
+            clear_list(&wheel->levels[level][i]);
+        }
+    }
+    free(wheel);
+}
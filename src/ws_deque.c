@@ -0,0 +1,357 @@
+#include <sched.h>
+#include <time.h>
+#include "ws_deque.h"
+
+// 内存序参照 Lê 等人《Correct and Efficient Work-Stealing for Weak Memory Models》
+
+static WSArray* array_create(size_t capacity) {
+    WSArray* array = malloc(sizeof(WSArray) + capacity * sizeof(_Atomic(void *)));
+    if (!array) return NULL;
+
+    array->capacity = capacity;
+    array->retired = NULL;
+    return array;
+}
+
+static void* array_get(WSArray* array, int64_t index) {
+    return atomic_load_explicit(&array->items[index & (array->capacity - 1)], memory_order_relaxed);
+}
+
+static void array_put(WSArray* array, int64_t index, void* item) {
+    atomic_store_explicit(&array->items[index & (array->capacity - 1)], item, memory_order_relaxed);
+}
+
+// 容量翻倍并复制 [top, bottom) 区间，旧数组挂到新数组的 retired 链上
+static WSArray* array_grow(WSArray* old, int64_t top, int64_t bottom) {
+    WSArray* array = array_create(old->capacity * 2);
+    if (!array) return NULL;
+
+    for (int64_t i = top; i < bottom; i++) {
+        array_put(array, i, array_get(old, i));
+    }
+    array->retired = old;
+    return array;
+}
+
+bool ws_deque_init(WSDeque* deque, size_t capacity) {
+    if (!deque) return false;
+
+    size_t size = 16;
+    while (size < capacity) {
+        size *= 2;
+    }
+
+    WSArray* array = array_create(size);
+    if (!array) return false;
+
+    atomic_init(&deque->top, 0);
+    atomic_init(&deque->bottom, 0);
+    atomic_init(&deque->array, array);
+    return true;
+}
+
+void ws_deque_destroy(WSDeque* deque) {
+    if (!deque) return;
+
+    WSArray* array = atomic_load(&deque->array);
+    while (array) {
+        WSArray* retired = array->retired;
+        free(array);
+        array = retired;
+    }
+    atomic_store(&deque->array, NULL);
+}
+
+bool ws_deque_push(WSDeque* deque, void* item) {
+    if (!deque || !item) return false;
+
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    WSArray* array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+
+    if (bottom - top > (int64_t)array->capacity - 1) {
+        WSArray* grown = array_grow(array, top, bottom);
+        if (!grown) return false;
+        atomic_store_explicit(&deque->array, grown, memory_order_release);
+        array = grown;
+    }
+
+    array_put(array, bottom, item);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release);
+    return true;
+}
+
+void* ws_deque_pop(WSDeque* deque) {
+    if (!deque) return NULL;
+
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    WSArray* array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    void* item = NULL;
+    if (top <= bottom) {
+        item = array_get(array, bottom);
+        if (top == bottom) {
+            // 只剩最后一个元素：与窃取者竞争
+            if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                         memory_order_seq_cst,
+                                                         memory_order_relaxed)) {
+                item = NULL;
+            }
+            atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        }
+    } else {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    }
+    return item;
+}
+
+void* ws_deque_steal(WSDeque* deque) {
+    if (!deque) return NULL;
+
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+    if (top >= bottom) return NULL;
+
+    WSArray* array = atomic_load_explicit(&deque->array, memory_order_acquire);
+    void* item = array_get(array, top);
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                 memory_order_seq_cst,
+                                                 memory_order_relaxed)) {
+        return NULL;
+    }
+    return item;
+}
+
+size_t ws_deque_size(WSDeque* deque) {
+    if (!deque) return 0;
+
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+    return bottom > top ? (size_t)(bottom - top) : 0;
+}
+
+// ==================== 工作线程池 ====================
+
+typedef struct {
+    task_fn fn;
+    void* arg;
+} PoolTask;
+
+static __thread Worker* current_worker = NULL;
+
+static PoolTask* take_injected(WorkerPool* pool) {
+    PoolTask* task = NULL;
+
+    pthread_mutex_lock(&pool->lock);
+    if (pool->injected.head) {
+        task = pool->injected.head->data;
+        delete_at_head(&pool->injected);
+        atomic_fetch_sub(&pool->injected_count, 1);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return task;
+}
+
+static PoolTask* find_task(Worker* self) {
+    WorkerPool* pool = self->pool;
+
+    PoolTask* task = ws_deque_pop(&self->deque);
+    if (task) return task;
+
+    // 先无锁读取计数，避免注入链表为空时也去竞争互斥锁
+    if (atomic_load_explicit(&pool->injected_count, memory_order_relaxed) > 0) {
+        task = take_injected(pool);
+        if (task) return task;
+    }
+
+    // 随机选择起点依次尝试窃取其他线程
+    size_t count = pool->worker_count;
+    size_t start = (size_t)rand_r(&self->seed) % count;
+    for (size_t i = 0; i < count; i++) {
+        Worker* victim = &pool->workers[(start + i) % count];
+        if (victim == self) continue;
+
+        task = ws_deque_steal(&victim->deque);
+        if (task) {
+            self->stolen++;
+            return task;
+        }
+    }
+    return NULL;
+}
+
+static void run_task(Worker* self, PoolTask* task) {
+    WorkerPool* pool = self->pool;
+
+    task->fn(task->arg);
+    free(task);
+    self->executed++;
+
+    if (atomic_fetch_sub(&pool->pending, 1) == 1) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_broadcast(&pool->idle);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+static void* worker_main(void* arg) {
+    Worker* self = arg;
+    WorkerPool* pool = self->pool;
+    current_worker = self;
+
+    size_t misses = 0;
+    while (!atomic_load(&pool->stopping)) {
+        PoolTask* task = find_task(self);
+        if (task) {
+            run_task(self, task);
+            misses = 0;
+            continue;
+        }
+
+        if (++misses < 64) {
+            sched_yield();
+            continue;
+        }
+
+        // 长时间找不到任务：睡眠。其他线程队列中的新任务不保证发出通知，因此限时醒来再试
+        pthread_mutex_lock(&pool->lock);
+        if (!atomic_load(&pool->stopping) && pool->injected.size == 0) {
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += 1000000;
+            if (deadline.tv_nsec >= 1000000000) {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000;
+            }
+            atomic_fetch_add(&pool->sleeping, 1);
+            pthread_cond_timedwait(&pool->wakeup, &pool->lock, &deadline);
+            atomic_fetch_sub(&pool->sleeping, 1);
+        }
+        pthread_mutex_unlock(&pool->lock);
+        misses = 0;
+    }
+
+    current_worker = NULL;
+    return NULL;
+}
+
+// 停止并回收前 started 个线程与前 ready 个队列；创建失败时回滚已完成的部分，销毁时回收全部
+static void pool_teardown(WorkerPool* pool, size_t started, size_t ready) {
+    pthread_mutex_lock(&pool->lock);
+    atomic_store(&pool->stopping, true);
+    pthread_cond_broadcast(&pool->wakeup);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (size_t i = 0; i < started; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+    for (size_t i = 0; i < ready; i++) {
+        ws_deque_destroy(&pool->workers[i].deque);
+    }
+
+    clear_list(&pool->injected);
+    pthread_cond_destroy(&pool->idle);
+    pthread_cond_destroy(&pool->wakeup);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool);
+}
+
+WorkerPool* worker_pool_create(size_t worker_count) {
+    if (worker_count == 0) return NULL;
+
+    WorkerPool* pool = malloc(sizeof(WorkerPool));
+    if (!pool) return NULL;
+
+    pool->workers = calloc(worker_count, sizeof(Worker));
+    if (!pool->workers) {
+        free(pool);
+        return NULL;
+    }
+    pool->worker_count = worker_count;
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wakeup, NULL);
+    pthread_cond_init(&pool->idle, NULL);
+    init_list_inplace(&pool->injected, NULL, NULL);
+    atomic_init(&pool->injected_count, 0);
+    atomic_init(&pool->pending, 0);
+    atomic_init(&pool->sleeping, 0);
+    atomic_init(&pool->stopping, false);
+
+    for (size_t i = 0; i < worker_count; i++) {
+        Worker* worker = &pool->workers[i];
+        worker->pool = pool;
+        worker->index = i;
+        worker->seed = (unsigned int)i * 2654435761u + 1;
+        if (!ws_deque_init(&worker->deque, 256)) {
+            pool_teardown(pool, 0, i);
+            return NULL;
+        }
+    }
+
+    // 所有队列就绪后再启动线程，避免窃取未初始化的队列
+    for (size_t i = 0; i < worker_count; i++) {
+        if (pthread_create(&pool->workers[i].thread, NULL, worker_main, &pool->workers[i]) != 0) {
+            pool_teardown(pool, i, worker_count);
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+bool worker_pool_submit(WorkerPool* pool, task_fn fn, void* arg) {
+    if (!pool || !fn) return false;
+
+    PoolTask* task = malloc(sizeof(PoolTask));
+    if (!task) return false;
+    task->fn = fn;
+    task->arg = arg;
+
+    atomic_fetch_add(&pool->pending, 1);
+
+    // 工作线程内提交：压入本线程队列，无锁
+    if (current_worker && current_worker->pool == pool &&
+        ws_deque_push(&current_worker->deque, task)) {
+        if (atomic_load(&pool->sleeping) > 0) {
+            pthread_cond_signal(&pool->wakeup);
+        }
+        return true;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    bool ok = insert_at_tail(&pool->injected, task) != NULL;
+    if (ok) atomic_fetch_add(&pool->injected_count, 1);
+    pthread_cond_signal(&pool->wakeup);
+    pthread_mutex_unlock(&pool->lock);
+
+    if (!ok) {
+        atomic_fetch_sub(&pool->pending, 1);
+        free(task);
+    }
+    return ok;
+}
+
+void worker_pool_wait(WorkerPool* pool) {
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->lock);
+    while (atomic_load(&pool->pending) > 0) {
+        pthread_cond_wait(&pool->idle, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+void worker_pool_destroy(WorkerPool* pool) {
+    if (!pool) return;
+
+    worker_pool_wait(pool);
+    pool_teardown(pool, pool->worker_count, pool->worker_count);
+}
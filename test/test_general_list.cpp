@@ -0,0 +1,377 @@
+#include <cassert>
+#include <cstdio>
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../include/general_list.hpp"
+
+// 记录分配次数的分配器，用于确认每个元素只分配一次、全部归还
+static long live_allocations = 0;
+static long total_allocations = 0;
+
+template <class T>
+struct counting_allocator {
+    using value_type = T;
+
+    counting_allocator() = default;
+    template <class U>
+    counting_allocator(const counting_allocator<U> &) {}
+
+    T *allocate(std::size_t n) {
+        live_allocations++;
+        total_allocations++;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T *p, std::size_t n) {
+        live_allocations--;
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template <class U>
+    bool operator==(const counting_allocator<U> &) const { return true; }
+    template <class U>
+    bool operator!=(const counting_allocator<U> &) const { return false; }
+};
+
+// 记录构造 / 复制 / 移动次数，可设置在第 n 次构造时抛出异常
+struct Tracked {
+    static int alive;
+    static int copies;
+    static int throw_countdown;
+
+    int value;
+
+    explicit Tracked(int v) : value(v) {
+        if (throw_countdown > 0 && --throw_countdown == 0) throw std::runtime_error("construct");
+        alive++;
+    }
+    Tracked(const Tracked &other) : value(other.value) {
+        copies++;
+        alive++;
+    }
+    Tracked(Tracked &&other) noexcept : value(other.value) { alive++; }
+    Tracked &operator=(const Tracked &other) {
+        value = other.value;
+        copies++;
+        return *this;
+    }
+    ~Tracked() { alive--; }
+
+    bool operator==(const Tracked &other) const { return value == other.value; }
+    bool operator<(const Tracked &other) const { return value < other.value; }
+};
+
+int Tracked::alive = 0;
+int Tracked::copies = 0;
+int Tracked::throw_countdown = 0;
+
+template <class List>
+static void assert_values(const List &list, std::vector<int> values) {
+    assert(list.size() == values.size());
+    assert(std::equal(list.begin(), list.end(), values.begin(), values.end()));
+    assert(std::equal(list.rbegin(), list.rend(), values.rbegin(), values.rend()));
+}
+
+// 测试1：插入与删除
+void test_basic_operations() {
+    printf("\n=== 测试1：插入与删除 ===\n");
+
+    general::list<int> list;
+    assert(list.empty() && list.begin() == list.end());
+    list.push_back(2);
+    list.push_front(1);
+    list.emplace_back(4);
+    assert(*list.emplace_at(2, 3) == 3);
+    assert(*list.emplace_at(0, 0) == 0);
+    assert(*list.emplace_at(5, 5) == 5);
+    assert_values(list, {0, 1, 2, 3, 4, 5});
+    assert(list.front() == 0 && list.back() == 5);
+
+    bool thrown = false;
+    try {
+        list.emplace_at(7, 7);
+    } catch (const std::out_of_range &) {
+        thrown = true;
+    }
+    assert(thrown && list.size() == 6);
+
+    list.pop_front();
+    list.pop_back();
+    auto it = list.erase(std::find(list.begin(), list.end(), 2));
+    assert(*it == 3);
+    assert_values(list, {1, 3, 4});
+    assert(list.remove_if([](int v) { return v > 2; }) == 2);
+    assert_values(list, {1});
+    list.clear();
+    assert(list.empty());
+    printf("✓ emplace / push / emplace_at / erase / pop / remove_if 正确\n");
+}
+
+// 测试2：只移动的元素
+void test_move_only() {
+    printf("\n=== 测试2：只移动的元素 ===\n");
+
+    general::list<std::unique_ptr<int>> list;
+    list.emplace_back(new int(1));
+    list.push_back(std::make_unique<int>(2));
+    list.emplace_front(std::make_unique<int>(0));
+    assert(*list.front() == 0 && *list.back() == 2);
+
+    general::list<std::unique_ptr<int>> moved(std::move(list));
+    assert(list.empty() && moved.size() == 3);
+    list = std::move(moved);
+    assert(moved.empty() && *list.back() == 2);
+
+    // 元素原地构造，插入、排序、反转都不复制
+    Tracked::copies = 0;
+    {
+        general::list<Tracked> tracked;
+        for (int i = 5; i > 0; i--) {
+            tracked.emplace_back(i);
+        }
+        tracked.sort();
+        tracked.reverse();
+        tracked.sort();
+        assert(tracked.front().value == 1 && tracked.back().value == 5);
+        assert(Tracked::alive == 5);
+    }
+    assert(Tracked::copies == 0 && Tracked::alive == 0);
+    printf("✓ unique_ptr 可插入、移动构造与赋值，原地构造不产生复制\n");
+}
+
+// 测试3：迭代器与标准算法
+void test_iterators() {
+    printf("\n=== 测试3：迭代器与标准算法 ===\n");
+
+    general::list<int> list{5, 3, 8, 1, 9, 2};
+    assert(std::accumulate(list.begin(), list.end(), 0) == 28);
+    assert(std::count_if(list.cbegin(), list.cend(), [](int v) { return v % 2 == 1; }) == 4);
+    assert(std::distance(list.begin(), list.end()) == 6);
+    assert(*std::max_element(list.begin(), list.end()) == 9);
+    assert(*std::prev(list.end()) == 2 && *--list.end() == 2);
+
+    // 其他元素的迭代器在插入、删除后保持有效
+    auto eight = std::find(list.begin(), list.end(), 8);
+    list.erase(std::find(list.begin(), list.end(), 3));
+    list.emplace(eight, 7);
+    assert(*eight == 8 && *std::prev(eight) == 7);
+
+    std::reverse(list.begin(), list.end());
+    assert_values(list, {2, 9, 1, 8, 7, 5});
+    list.sort(std::greater<>());
+    assert(std::is_sorted(list.rbegin(), list.rend()));
+    list.sort();
+    assert(std::is_sorted(list.begin(), list.end()));
+
+    general::list<int>::const_iterator cit = list.begin();
+    assert(cit == list.cbegin() && *cit == 1);
+
+    // 稳定排序：相等键保持原顺序
+    general::list<std::pair<int, int>> pairs{{1, 0}, {0, 1}, {1, 2}, {0, 3}};
+    pairs.sort([](const auto &a, const auto &b) { return a.first < b.first; });
+    assert(pairs.front().second == 1 && pairs.back().second == 2);
+    printf("✓ 双向迭代器可用于 <algorithm>，插入删除不影响其他迭代器，排序稳定\n");
+}
+
+// 测试4：splice 与 extract
+void test_splice_extract() {
+    printf("\n=== 测试4：splice 与 extract ===\n");
+
+    general::list<int> a{1, 2, 3};
+    general::list<int> b{10, 20, 30, 40};
+    auto twenty = std::find(b.begin(), b.end(), 20);
+
+    // 单个节点：迭代器随节点移动到另一个链表
+    a.splice(a.begin(), b, twenty);
+    assert_values(a, {20, 1, 2, 3});
+    assert_values(b, {10, 30, 40});
+    assert(*twenty == 20 && twenty == a.begin());
+
+    // 一段节点
+    a.splice(a.end(), b, std::next(b.begin()), b.end());
+    assert_values(a, {20, 1, 2, 3, 30, 40});
+    assert_values(b, {10});
+
+    // 链表内移动
+    a.splice(a.begin(), a, std::prev(a.end()));
+    a.splice(a.end(), a, a.begin(), std::next(a.begin(), 2));
+    assert_values(a, {1, 2, 3, 30, 40, 20});
+
+    // 整个链表
+    b.splice(b.begin(), a);
+    assert(a.empty());
+    assert_values(b, {1, 2, 3, 30, 40, 20, 10});
+
+    // 尾节点移到另一个链表后，从它前进到的是新链表的 end()，再后退回到它自己
+    {
+        general::list<int> from{7, 8};
+        general::list<int> to{9};
+        auto last = std::prev(from.end());
+        to.splice(to.end(), from);
+        assert(from.empty() && std::next(last) == to.end());
+        assert(--std::next(last) == last && *std::prev(to.end()) == 8);
+    }
+
+    // extract 摘下节点，元素地址不变，可挂回另一个链表
+    auto thirty = std::find(b.begin(), b.end(), 30);
+    int *address = &*thirty;
+    auto handle = b.extract(thirty);
+    assert(handle && handle.value() == 30 && b.size() == 6);
+    handle.value() = 31;
+    auto inserted = a.insert(a.end(), std::move(handle));
+    assert(handle.empty() && &*inserted == address);
+    assert_values(a, {31});
+
+    // 未挂回的句柄析构时释放元素
+    {
+        general::list<Tracked> tracked;
+        tracked.emplace_back(1);
+        tracked.emplace_back(2);
+        auto dropped = tracked.extract(tracked.begin());
+        assert(Tracked::alive == 2 && tracked.size() == 1);
+    }
+    assert(Tracked::alive == 0);
+    printf("✓ splice 单节点 / 一段 / 整表、extract 与挂回只改链接\n");
+}
+
+// 测试5：分配器
+void test_allocators() {
+    printf("\n=== 测试5：分配器 ===\n");
+
+    // 每个元素恰好一次分配，清空后全部归还
+    live_allocations = 0;
+    total_allocations = 0;
+    {
+        general::list<int, counting_allocator<int>> list;
+        for (int i = 0; i < 100; i++) {
+            list.push_back(i);
+        }
+        assert(total_allocations == 100 && live_allocations == 100);
+        list.remove_if([](int v) { return v % 2 == 0; });
+        assert(live_allocations == 50);
+        general::list<int, counting_allocator<int>> copy(list);
+        assert(copy == list && live_allocations == 100);
+    }
+    assert(live_allocations == 0);
+
+    // pmr：节点和元素内部的字符串都从同一内存资源分配
+    char buffer[1 << 16];
+    std::pmr::monotonic_buffer_resource pool(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    {
+        general::pmr::list<std::pmr::string> list(&pool);
+        list.emplace_back("a string long enough to bypass the small string buffer");
+        list.emplace_front(40, 'x');
+        assert(list.back().get_allocator().resource() == &pool);
+        assert(list.get_allocator().resource() == &pool);
+        char *first = reinterpret_cast<char *>(&list.front());
+        assert(first >= buffer && first < buffer + sizeof(buffer));
+        assert(list.back().data() >= buffer && list.back().data() < buffer + sizeof(buffer));
+
+        // 分配器不同的移动构造逐个移动元素，元素改用新资源
+        general::pmr::list<std::pmr::string> other(std::move(list), std::pmr::new_delete_resource());
+        assert(other.size() == 2 && other.front().get_allocator().resource() == std::pmr::new_delete_resource());
+    }
+    printf("✓ 每个元素一次分配，pmr 资源传递到元素内部\n");
+}
+
+// 测试6：异常安全
+void test_exception_safety() {
+    printf("\n=== 测试6：异常安全 ===\n");
+
+    live_allocations = 0;
+    {
+        general::list<Tracked, counting_allocator<Tracked>> list;
+        list.emplace_back(1);
+        list.emplace_back(2);
+
+        Tracked::throw_countdown = 1;
+        bool thrown = false;
+        try {
+            list.emplace_at(1, 3);
+        } catch (const std::runtime_error &) {
+            thrown = true;
+        }
+        assert(thrown && list.size() == 2 && live_allocations == 2);
+        assert(list.front().value == 1 && list.back().value == 2);
+
+        // 构造中途失败时已构造的元素全部释放
+        std::vector<int> values{1, 2, 3, 4};
+        Tracked::throw_countdown = 3;
+        thrown = false;
+        try {
+            general::list<Tracked, counting_allocator<Tracked>> partial(values.begin(), values.end());
+        } catch (const std::runtime_error &) {
+            thrown = true;
+        }
+        assert(thrown && live_allocations == 2 && Tracked::alive == 2);
+    }
+    assert(live_allocations == 0 && Tracked::alive == 0);
+    printf("✓ 元素构造抛出异常时链表不变、无泄漏\n");
+}
+
+// 测试7：复制、赋值与交换
+void test_copy_assign_swap() {
+    printf("\n=== 测试7：复制、赋值与交换 ===\n");
+
+    general::list<std::string> a{"one", "two", "three"};
+    general::list<std::string> b(a);
+    assert(a == b);
+    b.back() = "THREE";
+    assert(a != b && a.back() == "three");
+
+    // 复制赋值复用已有节点
+    general::list<std::string> c{"x"};
+    c = a;
+    assert(c == a);
+    c = {"p", "q"};
+    assert(c.size() == 2 && c.front() == "p");
+
+    auto two = std::next(a.begin());
+    a.swap(c);
+    assert(c.size() == 3 && *two == "two" && a.front() == "p");
+    swap(a, c);
+    assert(a.size() == 3 && c.size() == 2);
+
+    // 交换、移动后元素的迭代器随节点转到另一个链表，--end() 仍正确
+    auto last = std::prev(a.end());
+    a.swap(c);
+    assert(std::next(last) == c.end() && --std::next(last) == last);
+    general::list<std::string> moved(std::move(c));
+    assert(c.empty() && c.begin() == c.end());
+    assert(std::next(last) == moved.end() && *--moved.end() == "three");
+    c = std::move(moved);
+    a.swap(c);
+    assert(a.size() == 3 && c.size() == 2 && std::prev(a.end()) == last);
+
+    assert(a.find("two") == two && a.find("four") == a.end());
+    assert(a.remove("two") == 1 && a.size() == 2);
+
+    // 按链表内的元素删除：匹配的节点在扫描结束后才销毁
+    general::list<std::string> repeated{"dup", "x", "dup", "dup"};
+    assert(repeated.remove(repeated.front()) == 3);
+    assert(repeated.size() == 1 && repeated.front() == "x");
+    printf("✓ 复制、赋值、交换、查找正确\n");
+}
+
+int main() {
+    printf("开始测试 C++ 链表模板...\n");
+
+    test_basic_operations();
+    test_move_only();
+    test_iterators();
+    test_splice_extract();
+    test_allocators();
+    test_exception_safety();
+    test_copy_assign_swap();
+
+    printf("\n================================\n");
+    printf("所有测试通过！C++ 链表模板实现正确。\n");
+    printf("================================\n");
+
+    return 0;
+}
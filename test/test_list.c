@@ -3,7 +3,22 @@
 #include <assert.h>
 #include <string.h>
 #include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
 #include "../include/list.h"
+#include "../include/timer_wheel.h"
+#include "../include/lru_cache.h"
+#include "../include/list_trace.h"
+#include "../include/list_journal.h"
+#include "../include/list_pipeline.h"
+#include "../include/paged_list.h"
+#include "../include/sharded_list.h"
+#include "../include/ws_deque.h"
+#include "../include/shm_list.h"
+#include "../include/adaptive_list.h"
+#include "../include/id_list.h"
 
 // 测试整数类型的比较函数
 int int_cmp(const void *a, const void *b) {
@@ -57,6 +72,49 @@ int is_long_string(const void *data) {
     return strlen((char *)data) >= min_length;
 }
 
+// 整数哈希函数
+uint64_t int_hash(const void *data) {
+    uint64_t x = (uint64_t)(int64_t)*(int *)data;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return x;
+}
+
+// 分配一个整数
+int *new_int(int value) {
+    int *num = malloc(sizeof(int));
+    *num = value;
+    return num;
+}
+
+// 整数复制函数
+void *int_copy(const void *data) {
+    return new_int(*(const int *)data);
+}
+
+// 复制到第 N 次时失败的整数复制函数，用于测试回滚
+static int copy_budget = 0;
+void *int_copy_limited(const void *data) {
+    if (copy_budget-- <= 0) return NULL;
+    return int_copy(data);
+}
+
+// 整数序列化 / 反序列化函数
+size_t int_serialize(const void *data, void *buf, size_t capacity) {
+    if (capacity >= sizeof(int)) {
+        memcpy(buf, data, sizeof(int));
+    }
+    return sizeof(int);
+}
+
+void *int_deserialize(const void *buf, size_t length) {
+    assert(length == sizeof(int));
+    int *num = malloc(sizeof(int));
+    memcpy(num, buf, sizeof(int));
+    return num;
+}
+
 // 整数数据释放函数
 void int_free(void *data) {
     free(data);
@@ -595,6 +653,2578 @@ void test_comprehensive() {
     destroy_list(list);
 }
 
+// 测试10：分层时间轮
+void test_timer_wheel() {
+    printf("\n=== 测试10：分层时间轮 ===\n");
+
+    TimerWheel *wheel = timer_wheel_create(0, int_free);
+    assert(wheel != NULL);
+
+    // 覆盖各层以及超出时间轮范围的到期时刻
+    uint64_t deadlines[] = {0, 1, 255, 256, 300, 16383, 16384, 70000,
+                            1048576 + 7, 67108864 + 3, ((uint64_t)1 << 33) + 5};
+    int n = sizeof(deadlines) / sizeof(deadlines[0]);
+    for (int i = 0; i < n; i++) {
+        int *idx = malloc(sizeof(int));
+        *idx = i;
+        assert(timer_wheel_schedule(wheel, deadlines[i], idx) != NULL);
+    }
+    assert(timer_wheel_pending(wheel) == (size_t)n);
+    printf("✓ 跨层调度成功\n");
+
+    // 逐个推进到每个到期时刻，检查恰好到期一个且是对应的定时器
+    List *expired = init_list(int_cmp, int_free);
+    for (int i = 0; i < n; i++) {
+        if (i > 0) {
+            assert(timer_wheel_advance(wheel, deadlines[i] - 1, expired) == 0);
+        }
+        assert(timer_wheel_advance(wheel, deadlines[i], expired) == 1);
+        assert(*(int *)expired->tail->data == i);
+    }
+    assert(get_length(expired) == (size_t)n);
+    assert(timer_wheel_pending(wheel) == 0);
+    printf("✓ 各层定时器均在到期时刻触发\n");
+    clear_list(expired);
+
+    // 取消与重新调度
+    int *a = malloc(sizeof(int));
+    int *b = malloc(sizeof(int));
+    *a = 1;
+    *b = 2;
+    uint64_t now = deadlines[n - 1];
+    Timer *ta = timer_wheel_schedule(wheel, now + 1000, a);
+    Timer *tb = timer_wheel_schedule(wheel, now + 2000, b);
+    assert(timer_wheel_cancel(wheel, ta) == true);
+    assert(timer_wheel_reschedule(wheel, tb, now + 10) == true);
+    assert(timer_wheel_advance(wheel, now + 10, expired) == 1);
+    assert(*(int *)expired->head->data == 2);
+    assert(timer_wheel_advance(wheel, now + 5000, expired) == 0);
+    printf("✓ 取消与重新调度成功\n");
+    clear_list(expired);
+
+    // 大量随机定时器：每个都必须在第一次推进越过其到期时刻时触发
+    now += 5001;
+    int total = 100000;
+    for (int i = 0; i < total; i++) {
+        int *deadline = malloc(sizeof(int));
+        *deadline = rand() % 200000;
+        timer_wheel_schedule(wheel, now + *deadline, deadline);
+    }
+    size_t fired = 0;
+    for (uint64_t t = now; t < now + 200000; t += 997) {
+        fired += timer_wheel_advance(wheel, t, expired);
+        for (ListNode *node = expired->head; node; node = node->next) {
+            assert(now + *(int *)node->data <= t);
+            assert(now + *(int *)node->data > t - 997);
+        }
+        clear_list(expired);
+    }
+    fired += timer_wheel_advance(wheel, now + 200000, expired);
+    assert(fired == (size_t)total);
+    printf("✓ %d 个随机定时器全部按时触发\n", total);
+
+    // 推进到 tick 上限：不回绕、不死循环，到期时刻为 UINT64_MAX 的定时器保持挂起
+    clear_list(expired);
+    timer_wheel_destroy(wheel);
+    wheel = timer_wheel_create(UINT64_MAX - 100000, int_free);
+    timer_wheel_schedule(wheel, UINT64_MAX - 70000, new_int(6));
+    timer_wheel_schedule(wheel, UINT64_MAX - 5, new_int(7));
+    timer_wheel_schedule(wheel, UINT64_MAX, new_int(8));
+    assert(timer_wheel_advance(wheel, UINT64_MAX, expired) == 2);
+    assert(*(int *)expired->head->data == 6 && *(int *)expired->tail->data == 7);
+    assert(timer_wheel_advance(wheel, UINT64_MAX, expired) == 0);
+    assert(timer_wheel_pending(wheel) == 1);
+    printf("✓ 推进到 tick 上限时正常返回\n");
+    clear_list(expired);
+
+    destroy_list(expired);
+    timer_wheel_destroy(wheel);
+}
+
+// 测试11：LRU 缓存
+void test_lru_cache() {
+    printf("\n=== 测试11：LRU缓存 ===\n");
+
+    // 按条目数限制
+    LRUCache *cache = lru_create(int_hash, int_cmp, int_free, int_free, 3, 0);
+    assert(cache != NULL);
+    for (int i = 1; i <= 3; i++) {
+        assert(lru_put(cache, new_int(i), new_int(i * 10), sizeof(int)) == true);
+    }
+    int key = 1;
+    assert(*(int *)lru_get(cache, &key) == 10);     // 1 成为最近使用
+    assert(lru_put(cache, new_int(4), new_int(40), sizeof(int)) == true);
+    key = 2;
+    assert(lru_get(cache, &key) == NULL);           // 2 被淘汰
+    assert(lru_size(cache) == 3);
+    assert(*(int *)((LRUEntry *)cache->list.head->data)->key == 4);
+    assert(*(int *)((LRUEntry *)cache->list.tail->data)->key == 3);
+    printf("✓ 按条目数淘汰最久未使用的条目\n");
+
+    // 替换已有键
+    assert(lru_put(cache, new_int(3), new_int(33), sizeof(int)) == true);
+    key = 3;
+    assert(*(int *)lru_peek(cache, &key) == 33);
+    assert(lru_size(cache) == 3);
+
+    // 用缓存中的键和值本身重新放入（只更新字节数），不能释放它们
+    LRUEntry *stored = cache->list.head->data;
+    void *stored_value = stored->value;
+    assert(lru_put(cache, stored->key, stored_value, 2 * sizeof(int)) == true);
+    assert(*(int *)lru_peek(cache, &key) == 33 && lru_peek(cache, &key) == stored_value);
+    assert(cache->bytes == 4 * sizeof(int));
+    printf("✓ 替换已有键成功\n");
+
+    LRUStats stats = lru_stats(cache);
+    assert(stats.hits == 1);
+    assert(stats.misses == 1);
+    assert(stats.evictions == 1);
+    printf("✓ 命中/未命中/淘汰统计正确\n");
+
+    assert(lru_remove(cache, &key) == true);
+    assert(lru_remove(cache, &key) == false);
+    assert(lru_evict_tail(cache) == true);
+    assert(lru_size(cache) == 1);
+    lru_destroy(cache);
+
+    // 按字节数限制
+    cache = lru_create(int_hash, int_cmp, int_free, int_free, 0, 100);
+    assert(lru_put(cache, new_int(1), new_int(1), 40) == true);
+    assert(lru_put(cache, new_int(2), new_int(2), 40) == true);
+    assert(lru_put(cache, new_int(3), new_int(3), 40) == true);
+    assert(lru_size(cache) == 2);
+    assert(lru_bytes(cache) == 80);
+    int *too_big_key = new_int(4);
+    int *too_big_value = new_int(4);
+    assert(lru_put(cache, too_big_key, too_big_value, 101) == false);
+    free(too_big_key);
+    free(too_big_value);
+    printf("✓ 按字节数淘汰成功\n");
+    lru_destroy(cache);
+
+    // 大量条目触发索引扩容，并验证链表与索引一致
+    cache = lru_create(int_hash, int_cmp, int_free, int_free, 5000, 0);
+    for (int i = 0; i < 20000; i++) {
+        lru_put(cache, new_int(i), new_int(i), sizeof(int));
+        key = rand() % (i + 1);
+        lru_get(cache, &key);
+    }
+    assert(lru_size(cache) == 5000);
+    for (ListNode *node = cache->list.head; node; node = node->next) {
+        LRUEntry *entry = node->data;
+        assert(lru_peek(cache, entry->key) == entry->value);
+    }
+    printf("✓ 大量条目下链表与索引保持一致\n");
+    lru_destroy(cache);
+}
+
+// 测试12：复制与克隆
+void test_copy_and_clone() {
+    printf("\n=== 测试12：复制与克隆 ===\n");
+
+    List *src = init_list(int_cmp, int_free);
+    for (int i = 0; i < 10; i++) {
+        insert_at_tail(src, new_int(i));
+    }
+
+    // 深复制：副本与源链表互不影响
+    List *clone = clone_list(src, int_copy);
+    assert(clone != NULL);
+    assert(get_length(clone) == 10);
+    ListNode *a = src->head, *b = clone->head;
+    for (; a && b; a = a->next, b = b->next) {
+        assert(a->data != b->data);
+        assert(*(int *)a->data == *(int *)b->data);
+        assert(!b->next || b->next->prev == b);
+    }
+    assert(a == NULL && b == NULL);
+    assert(clone->head->prev == NULL && clone->tail->next == NULL);
+    printf("✓ 深复制克隆成功\n");
+
+    // 副本中的批量节点可以与普通节点混合增删
+    assert(delete_at_position(clone, 5) == true);
+    assert(delete_at_head(clone) == true);
+    insert_at_position(clone, new_int(100), 3);
+    assert(delete_at_tail(clone) == true);
+    assert(get_length(clone) == 8);
+    printf("✓ 批量分配的节点可逐个删除\n");
+
+    // 追加复制到非空链表尾部
+    assert(copy_list(clone, src, int_copy) == true);
+    assert(get_length(clone) == 18);
+    assert(*(int *)clone->tail->data == 9);
+    assert(clone->tail->prev->next == clone->tail);
+    printf("✓ 追加复制成功\n");
+
+    // 复制中途失败时回滚，目标链表不变
+    copy_budget = 4;
+    assert(copy_list(clone, src, int_copy_limited) == false);
+    assert(get_length(clone) == 18);
+    assert(*(int *)clone->tail->data == 9);
+    assert(clone->tail->next == NULL);
+    printf("✓ 复制失败时回滚成功\n");
+    destroy_list(clone);
+
+    // 浅复制：共享数据，副本不负责释放
+    List *shallow = clone_list(src, NULL);
+    assert(shallow != NULL);
+    assert(shallow->free_data == NULL);
+    assert(shallow->head->data == src->head->data);
+    destroy_list(shallow);
+    printf("✓ 浅复制克隆成功\n");
+
+    // 深复制到不持有数据的链表：副本无人释放，直接拒绝
+    List *borrowed = init_list(int_cmp, NULL);
+    assert(copy_list(borrowed, src, int_copy) == false);
+    assert(get_length(borrowed) == 0);
+    assert(copy_list(borrowed, src, NULL) == true);
+    assert(get_length(borrowed) == get_length(src));
+    destroy_list(borrowed);
+    printf("✓ 不持有数据的目标拒绝深复制\n");
+
+    // 性能对比：逐个尾插 vs 整块克隆
+    List *big = init_list(int_cmp, int_free);
+    for (int i = 0; i < 200000; i++) {
+        insert_at_tail(big, new_int(i));
+    }
+    clock_t start = clock();
+    List *manual = init_list(int_cmp, int_free);
+    for (ListNode *node = big->head; node; node = node->next) {
+        insert_at_tail(manual, int_copy(node->data));
+    }
+    clock_t end = clock();
+    printf("逐个尾插复制200000个元素耗时: %.4f秒\n", (double)(end - start) / CLOCKS_PER_SEC);
+
+    start = clock();
+    List *fast = clone_list(big, int_copy);
+    end = clock();
+    printf("clone_list复制200000个元素耗时: %.4f秒\n", (double)(end - start) / CLOCKS_PER_SEC);
+    assert(get_length(fast) == get_length(manual));
+
+    destroy_list(manual);
+    destroy_list(fast);
+    destroy_list(big);
+    destroy_list(src);
+}
+
+// 重新计算指纹，用于验证增量维护的结果
+uint64_t recomputed_fingerprint(List *list) {
+    enable_fingerprint(list, list->hash);
+    return get_fingerprint(list);
+}
+
+// 测试13：指纹与链表比较
+void test_fingerprint_compare() {
+    printf("\n=== 测试13：指纹与链表比较 ===\n");
+
+    List *a = init_list(int_cmp, int_free);
+    List *b = init_list(int_cmp, int_free);
+    assert(enable_fingerprint(a, int_hash) == true);
+    assert(enable_fingerprint(b, int_hash) == true);
+    assert(get_fingerprint(a) == get_fingerprint(b));
+    assert(compare_lists(a, b) == true);
+
+    // 以不同的操作序列构造相同内容 0..9
+    for (int i = 0; i < 10; i++) {
+        insert_at_tail(a, new_int(i));
+    }
+    for (int i = 9; i >= 0; i -= 2) {
+        insert_at_head(b, new_int(i));          // 1 3 5 7 9
+    }
+    for (int i = 0; i < 10; i += 2) {
+        insert_at_position(b, new_int(i), i);   // 0 1 2 3 ... 9
+    }
+    assert(get_fingerprint(a) == get_fingerprint(b));
+    assert(compare_lists(a, b) == true);
+    printf("✓ 相同内容的链表指纹相同\n");
+
+    // 顺序不同：指纹不同，直接判定不等
+    ListNode *node = get_node_at_position(b, 3);
+    int value = 4;
+    update_node(b, node, &value, int_update);   // 0 1 2 4 4 ...
+    node = get_node_at_position(b, 4);
+    value = 3;
+    update_node(b, node, &value, int_update);   // 0 1 2 4 3 ...
+    assert(get_fingerprint(a) != get_fingerprint(b));
+    assert(compare_lists(a, b) == false);
+    printf("✓ 顺序不同的链表指纹不同\n");
+
+    // 反转两次回到原指纹；反转一次与手工逆序构造的链表相等
+    uint64_t before = get_fingerprint(a);
+    assert(reverse_list(a) == true);
+    assert(*(int *)get_first_node(a)->data == 9 && *(int *)get_last_node(a)->data == 0);
+    assert(get_prev_node(a, get_first_node(a)) == NULL && get_next_node(a, get_last_node(a)) == NULL);
+    List *c = init_list(int_cmp, int_free);
+    enable_fingerprint(c, int_hash);
+    for (int i = 0; i < 10; i++) {
+        insert_at_head(c, new_int(i));
+    }
+    assert(get_fingerprint(a) == get_fingerprint(c));
+    assert(compare_lists(a, c) == true);
+    reverse_list(a);
+    assert(get_fingerprint(a) == before);
+    printf("✓ 反转时指纹O(1)维护\n");
+
+    // 随机增删改后，增量维护的指纹与重新计算的一致
+    for (int i = 0; i < 2000; i++) {
+        int op = rand() % 6;
+        int size = (int)get_length(c);
+        if (op == 0) {
+            insert_at_position(c, new_int(rand() % 50), size ? rand() % (size + 1) : 0);
+        } else if (op == 1 && size > 0) {
+            delete_at_position(c, rand() % size);
+        } else if (op == 2 && size > 0) {
+            value = rand() % 50;
+            update_node(c, get_node_at_position(c, rand() % size), &value, int_update);
+        } else if (op == 3) {
+            value = rand() % 50;
+            delete_by_value(c, &value);
+        } else if (op == 4 && size > 0) {
+            move_to_head(c, get_node_at_position(c, rand() % size));
+        } else if (size > 0) {
+            insert_before_node(c, get_node_at_position(c, rand() % size), new_int(rand() % 50));
+        }
+    }
+    uint64_t incremental = get_fingerprint(c);
+    assert(incremental == recomputed_fingerprint(c));
+    List *copy = clone_list(c, int_copy);
+    assert(get_fingerprint(copy) == incremental);
+    assert(compare_lists(c, copy) == true);
+    destroy_list(copy);
+    printf("✓ 随机操作后增量指纹与重算结果一致\n");
+
+    // 大链表末尾不同：指纹直接拒绝，无需逐个比较
+    List *big1 = init_list(int_cmp, int_free);
+    List *big2 = init_list(int_cmp, int_free);
+    enable_fingerprint(big1, int_hash);
+    enable_fingerprint(big2, int_hash);
+    for (int i = 0; i < 200000; i++) {
+        insert_at_tail(big1, new_int(i));
+        insert_at_tail(big2, new_int(i == 199999 ? -1 : i));
+    }
+    clock_t start = clock();
+    for (int i = 0; i < 1000; i++) {
+        assert(compare_lists(big1, big2) == false);
+    }
+    clock_t end = clock();
+    printf("1000次比较200000个元素的不等链表耗时: %.4f秒\n", (double)(end - start) / CLOCKS_PER_SEC);
+
+    destroy_list(big1);
+    destroy_list(big2);
+    destroy_list(a);
+    destroy_list(b);
+    destroy_list(c);
+}
+
+// 统计回放记录的测试后端
+typedef struct {
+    size_t counts[TRACE_OP_COUNT];
+    TraceRecord last;
+    TraceRecord first[8];   // 前 8 条记录
+} CountingReplay;
+
+void *counting_create(void) {
+    return calloc(1, sizeof(CountingReplay));
+}
+
+void counting_execute(void *ctx, const TraceRecord *record) {
+    CountingReplay *replay = ctx;
+    size_t seen = 0;
+    for (int op = 0; op < TRACE_OP_COUNT; op++) {
+        seen += replay->counts[op];
+    }
+    if (seen < 8) replay->first[seen] = *record;
+    replay->counts[record->op]++;
+    replay->last = *record;
+}
+
+static CountingReplay counting_result;
+void counting_destroy(void *ctx) {
+    counting_result = *(CountingReplay *)ctx;
+    free(ctx);
+}
+
+// 测试14：操作跟踪与回放
+void test_trace_replay() {
+    printf("\n=== 测试14：操作跟踪与回放 ===\n");
+
+    const char *path = "test_trace.bin";
+    assert(list_trace_open(path) == true);
+
+    // 模拟 -DLIST_TRACE 构建下的插入 / 查找 / 按位置删除 / 条件更新混合负载
+    List *list = init_list(int_cmp, int_free);
+    enable_fingerprint(list, int_hash);
+    for (int i = 0; i < 1000; i++) {
+        int *num = new_int(i);
+        list_trace_record(TRACE_INSERT_TAIL, list, -1, num);
+        insert_at_tail(list, num);
+    }
+    for (int i = 0; i < 200; i++) {
+        int key = rand() % 1000;
+        list_trace_record(TRACE_SEARCH, list, -1, &key);
+        int position = rand() % (int)get_length(list);
+        list_trace_record(TRACE_DELETE_POSITION, list, position, NULL);
+        delete_at_position(list, position);
+        if (i % 50 == 0) {
+            list_trace_record(TRACE_UPDATE_IF, list, -1, NULL);
+        }
+    }
+    assert(list_trace_count() == 1404);
+    list_trace_close();
+    printf("✓ 跟踪记录写入成功\n");
+
+    // 回放到统计后端，确认记录内容完整
+    TraceBackend counting = {"counting", counting_create, counting_execute, counting_destroy};
+    TraceReplayStats stats;
+    assert(list_trace_replay(path, &counting, &stats) == true);
+    assert(stats.ops == 1404);
+    assert(counting_result.counts[TRACE_INSERT_TAIL] == 1000);
+    assert(counting_result.counts[TRACE_SEARCH] == 200);
+    assert(counting_result.counts[TRACE_DELETE_POSITION] == 200);
+    assert(counting_result.counts[TRACE_UPDATE_IF] == 4);
+    assert(counting_result.last.op == TRACE_DELETE_POSITION);
+    assert(counting_result.last.size == 801);
+    printf("✓ 回放记录与采集一致\n");
+
+    // 回放到默认 List 后端并输出吞吐量与延迟
+    assert(list_trace_replay(path, &list_trace_list_backend, &stats) == true);
+    assert(stats.ops == 1404);
+    assert(stats.p50_nanos <= stats.p99_nanos && stats.p99_nanos <= stats.max_nanos);
+    list_trace_print_stats(stdout, list_trace_list_backend.name, &stats);
+    printf("✓ List 后端回放成功\n");
+
+    assert(list_trace_replay("no_such_trace.bin", &counting, &stats) == false);
+
+    // 未设置 hash：key_hash 按元素身份派生，查找记录与被查到元素的插入记录一致；
+    // 双链表操作的 key_hash 为另一个链表的标识
+    List *plain = init_list(int_cmp, int_free);
+    List *other = init_list(int_cmp, int_free);
+    assert(list_trace_open(path) == true);
+    int *five = new_int(5);
+    list_trace_record(TRACE_INSERT_TAIL, plain, -1, five);
+    insert_at_tail(plain, five);
+    list_trace_record(TRACE_CLEAR, other, -1, NULL);
+    list_trace_record(TRACE_CONCAT, plain, -1, other);
+    int key = 5;
+    list_trace_record(TRACE_SEARCH, plain, -1, &key);
+    key = 6;
+    list_trace_record(TRACE_SEARCH, plain, -1, &key);
+    list_trace_close();
+    assert(list_trace_replay(path, &counting, &stats) == true && stats.ops == 5);
+    TraceRecord *records = counting_result.first;
+    assert(records[0].key_hash != 0 && records[3].key_hash == records[0].key_hash);
+    assert(records[4].key_hash != records[0].key_hash);
+    assert(records[2].key_hash == records[1].list_id && records[2].size == 1);
+    assert(strcmp(list_trace_op_name(TRACE_CONCAT), "concat_lists") == 0);
+    assert(strcmp(list_trace_op_name(TRACE_COMPACT), "compact_list") == 0);
+    assert(list_trace_replay(path, &list_trace_list_backend, &stats) == true && stats.ops == 5);
+    printf("✓ 未设置 hash 时查找键与元素一致，双链表操作记录另一链表\n");
+    destroy_list(plain);
+    destroy_list(other);
+
+    remove(path);
+    destroy_list(list);
+}
+
+// 测试15：分页换出链表
+void test_paged_list() {
+    printf("\n=== 测试15：分页换出链表 ===\n");
+
+    PagedList *list = paged_list_create("test_paged.bin", 64, 4,
+                                        int_serialize, int_deserialize, int_free);
+    assert(list != NULL);
+
+    // 尾部追加远超内存页数的元素
+    int total = 20000;
+    for (int i = 0; i < total; i++) {
+        assert(paged_list_push_back(list, new_int(i)) == true);
+    }
+    assert(paged_list_size(list) == (size_t)total);
+    assert(paged_list_hot_pages(list) <= 4);
+    assert(list->page_outs > 0);
+    printf("✓ 追加%d个元素，内存中最多驻留4页\n", total);
+
+    // 顺序遍历
+    PagedIterator it = paged_list_begin(list);
+    int expected = 0;
+    for (int *value; (value = paged_list_next(&it)) != NULL; expected++) {
+        assert(*value == expected);
+    }
+    assert(expected == total);
+    printf("✓ 顺序遍历结果正确\n");
+
+    // 随机访问会把冷页换入
+    for (int i = 0; i < 200; i++) {
+        int index = rand() % total;
+        assert(*(int *)paged_list_get(list, index) == index);
+    }
+    assert(paged_list_hot_pages(list) <= 4);
+    printf("✓ 随机访问换入冷页成功\n");
+
+    // 头尾操作
+    for (int i = 1; i <= 100; i++) {
+        assert(paged_list_push_front(list, new_int(-i)) == true);
+    }
+    int *value = paged_list_pop_front(list);
+    assert(*value == -100);
+    free(value);
+    value = paged_list_pop_back(list);
+    assert(*value == total - 1);
+    free(value);
+    assert(*(int *)paged_list_get(list, 0) == -99);
+    assert(*(int *)paged_list_get(list, 99) == 0);
+    assert(paged_list_size(list) == (size_t)total + 98);
+
+    // 从头部弹出越过多个页，修改过的页写回后仍能正确换入
+    for (int i = -99; i < 5000; i++) {
+        value = paged_list_pop_front(list);
+        assert(*value == i);
+        free(value);
+    }
+    assert(*(int *)paged_list_get(list, 0) == 5000);
+    printf("✓ 头尾插入与弹出成功，换入 %zu 页，写出 %zu 页\n", list->page_ins, list->page_outs);
+
+    paged_list_destroy(list);
+    assert(fopen("test_paged.bin", "rb") == NULL);
+
+    // 先进先出：链表长度不变时，删除的页和搬走的页留下的空间被复用，换出文件不持续增长
+    list = paged_list_create("test_paged.bin", 64, 2, int_serialize, int_deserialize, int_free);
+    assert(list != NULL);
+    for (int i = 0; i < 1024; i++) {
+        assert(paged_list_push_back(list, new_int(i)) == true);
+    }
+    long steady_end = 0;
+    for (int round = 0; round < 50000; round++) {
+        value = paged_list_pop_front(list);
+        assert(*value == round);
+        free(value);
+        assert(paged_list_push_back(list, new_int(1024 + round)) == true);
+        if (round == 5000) steady_end = list->file_end;
+        if (round > 5000) assert(list->file_end <= 2 * steady_end);
+    }
+    long live_bytes = 1024 * (long)(4 + sizeof(int));
+    assert(list->file_end <= 2 * live_bytes);
+    printf("✓ 先进先出 50000 轮后换出文件 %ld 字节（存活数据 %ld 字节）\n", list->file_end, live_bytes);
+    paged_list_destroy(list);
+}
+
+#define SHARD_THREADS 8
+#define SHARD_INSERTS 50000
+
+typedef struct {
+    ShardedList *sharded;
+    List *shared;
+    pthread_mutex_t *lock;
+    int base;
+} ShardWorker;
+
+void *sharded_insert_worker(void *arg) {
+    ShardWorker *worker = arg;
+    for (int i = 0; i < SHARD_INSERTS; i++) {
+        sharded_list_insert(worker->sharded, new_int(worker->base + i));
+    }
+    return NULL;
+}
+
+void *shared_insert_worker(void *arg) {
+    ShardWorker *worker = arg;
+    for (int i = 0; i < SHARD_INSERTS; i++) {
+        int *num = new_int(worker->base + i);
+        pthread_mutex_lock(worker->lock);
+        insert_at_tail(worker->shared, num);
+        pthread_mutex_unlock(worker->lock);
+    }
+    return NULL;
+}
+
+double run_insert_workers(void *(*fn)(void *), ShardWorker *workers) {
+    pthread_t threads[SHARD_THREADS];
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < SHARD_THREADS; i++) {
+        pthread_create(&threads[i], NULL, fn, &workers[i]);
+    }
+    for (int i = 0; i < SHARD_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+void sum_ints(void *data, void *ctx) {
+    *(long long *)ctx += *(int *)data;
+}
+
+void first_int(void *data, void *ctx) {
+    if (!*(int **)ctx) *(int **)ctx = data;
+}
+
+// 测试16：分片链表
+void test_sharded_list() {
+    printf("\n=== 测试16：分片链表 ===\n");
+
+    // concat_lists 整段移动
+    List *a = init_list(int_cmp, int_free);
+    List *b = init_list(int_cmp, int_free);
+    enable_fingerprint(a, int_hash);
+    for (int i = 0; i < 5; i++) {
+        insert_at_tail(a, new_int(i));
+        insert_at_tail(b, new_int(i + 5));
+    }
+    assert(concat_lists(a, b) == true);
+    assert(get_length(a) == 10 && is_empty(b));
+    assert(b->head == NULL && b->tail == NULL);
+    assert(*(int *)a->tail->data == 9);
+    assert(*(int *)get_node_at_position(a, 5)->prev->data == 4);
+    uint64_t incremental = get_fingerprint(a);
+    assert(incremental == recomputed_fingerprint(a));
+    destroy_list(b);
+    printf("✓ concat_lists 整段移动成功\n");
+
+    ShardedList *sharded = sharded_list_create(SHARD_THREADS, int_cmp, int_free);
+    assert(sharded != NULL);
+    List *shared = init_list(int_cmp, int_free);
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+    ShardWorker workers[SHARD_THREADS];
+    for (int i = 0; i < SHARD_THREADS; i++) {
+        workers[i].sharded = sharded;
+        workers[i].shared = shared;
+        workers[i].lock = &lock;
+        workers[i].base = i * SHARD_INSERTS;
+    }
+
+    double shared_time = run_insert_workers(shared_insert_worker, workers);
+    double sharded_time = run_insert_workers(sharded_insert_worker, workers);
+    printf("%d线程共%d次尾插: 共享链表+互斥锁 %.4f秒, 分片链表 %.4f秒\n",
+           SHARD_THREADS, SHARD_THREADS * SHARD_INSERTS, shared_time, sharded_time);
+
+    size_t total = (size_t)SHARD_THREADS * SHARD_INSERTS;
+    assert(sharded_list_size(sharded) == total);
+    long long expected_sum = (long long)total * (total - 1) / 2;
+    long long sum = 0;
+    sharded_list_for_each(sharded, sum_ints, &sum);
+    assert(sum == expected_sum);
+    int key = 123457;
+    assert(*(int *)sharded_list_search(sharded, &key) == key);
+    key = -1;
+    assert(sharded_list_search(sharded, &key) == NULL);
+    printf("✓ 全局大小、遍历、查找正确\n");
+
+    // 分片上的墓碑与反转：大小与遍历按逻辑顺序，跳过已删除的节点
+    List *shard = &sharded->shards[0].list;
+    int removed = *(int *)get_first_node(shard)->data;
+    assert(enable_deferred_delete(shard, 0) == true);
+    assert(delete_at_head(shard) == true);
+    assert(reverse_list(shard) == true);
+    assert(sharded_list_size(sharded) == total - 1);
+    sum = 0;
+    sharded_list_for_each(sharded, sum_ints, &sum);
+    assert(sum == expected_sum - removed);
+    int *first = NULL;
+    sharded_list_for_each(sharded, first_int, &first);
+    assert(first == get_first_node(shard)->data && first == shard->tail->data);
+    disable_deferred_delete(shard);
+    assert(reverse_list(shard) == true);
+    total--;
+    printf("✓ 分片有墓碑或已反转时大小与遍历正确\n");
+
+    // 收集到一个链表：分片清空，链表完整
+    assert(sharded_list_collect(sharded, a) == true);
+    assert(sharded_list_size(sharded) == 0);
+    assert(get_length(a) == total + 10);
+    size_t count = 0;
+    for (ListNode *node = a->head; node; node = node->next) {
+        assert(!node->next || node->next->prev == node);
+        count++;
+    }
+    assert(count == total + 10);
+    printf("✓ 所有分片收集到一个链表\n");
+
+    destroy_list(a);
+    destroy_list(shared);
+    sharded_list_destroy(sharded);
+}
+
+#define STEAL_ITEMS 100000
+#define STEAL_THIEVES 3
+
+typedef struct {
+    WSDeque *deque;
+    atomic_int *seen;
+    atomic_bool *done;
+    size_t taken;
+} Thief;
+
+void *thief_worker(void *arg) {
+    Thief *thief = arg;
+    for (;;) {
+        bool finished = atomic_load(thief->done);
+        int *item = ws_deque_steal(thief->deque);
+        if (item) {
+            atomic_fetch_add(&thief->seen[*item], 1);
+            thief->taken++;
+        } else if (finished && ws_deque_size(thief->deque) == 0) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+static atomic_size_t pool_counter;
+
+void pool_leaf(void *arg) {
+    (void)arg;
+    atomic_fetch_add(&pool_counter, 1);
+}
+
+// 每个任务在工作线程内再派生两个子任务
+void pool_spawn(void *arg) {
+    WorkerPool *pool = arg;
+    atomic_fetch_add(&pool_counter, 1);
+    worker_pool_submit(pool, pool_leaf, NULL);
+    worker_pool_submit(pool, pool_leaf, NULL);
+}
+
+// 测试17：工作窃取队列与线程池
+void test_ws_deque() {
+    printf("\n=== 测试17：工作窃取队列与线程池 ===\n");
+
+    // 单线程语义：所有者后进先出，窃取者先进先出，超出初始容量自动扩容
+    WSDeque deque;
+    assert(ws_deque_init(&deque, 4) == true);
+    int values[100];
+    for (int i = 0; i < 100; i++) {
+        values[i] = i;
+        assert(ws_deque_push(&deque, &values[i]) == true);
+    }
+    assert(ws_deque_size(&deque) == 100);
+    assert(*(int *)ws_deque_pop(&deque) == 99);
+    assert(*(int *)ws_deque_steal(&deque) == 0);
+    assert(*(int *)ws_deque_steal(&deque) == 1);
+    assert(ws_deque_size(&deque) == 97);
+    while (ws_deque_pop(&deque)) {
+    }
+    assert(ws_deque_size(&deque) == 0);
+    assert(ws_deque_steal(&deque) == NULL);
+    ws_deque_destroy(&deque);
+    printf("✓ 所有者 LIFO / 窃取者 FIFO / 自动扩容正确\n");
+
+    // 并发窃取：所有者边压入边弹出，每个元素恰好被取走一次
+    int *items = malloc(STEAL_ITEMS * sizeof(int));
+    atomic_int *seen = calloc(STEAL_ITEMS, sizeof(atomic_int));
+    atomic_bool done = false;
+    assert(ws_deque_init(&deque, 16) == true);
+
+    Thief thieves[STEAL_THIEVES];
+    pthread_t threads[STEAL_THIEVES];
+    for (int i = 0; i < STEAL_THIEVES; i++) {
+        thieves[i].deque = &deque;
+        thieves[i].seen = seen;
+        thieves[i].done = &done;
+        thieves[i].taken = 0;
+        pthread_create(&threads[i], NULL, thief_worker, &thieves[i]);
+    }
+
+    size_t popped = 0;
+    for (int i = 0; i < STEAL_ITEMS; i++) {
+        items[i] = i;
+        ws_deque_push(&deque, &items[i]);
+        if (i % 3 == 0) {
+            int *item = ws_deque_pop(&deque);
+            if (item) {
+                atomic_fetch_add(&seen[*item], 1);
+                popped++;
+            }
+        }
+    }
+    atomic_store(&done, true);
+    for (int i = 0; i < STEAL_THIEVES; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    size_t stolen = 0;
+    for (int i = 0; i < STEAL_THIEVES; i++) {
+        stolen += thieves[i].taken;
+    }
+    assert(popped + stolen == STEAL_ITEMS);
+    for (int i = 0; i < STEAL_ITEMS; i++) {
+        assert(atomic_load(&seen[i]) == 1);
+    }
+    printf("✓ 并发窃取无丢失无重复（所有者取走%zu个，窃取者取走%zu个）\n", popped, stolen);
+    ws_deque_destroy(&deque);
+    free(seen);
+    free(items);
+
+    // 线程池：外部提交经注入链表分发，任务内提交进入本线程队列
+    WorkerPool *pool = worker_pool_create(4);
+    assert(pool != NULL);
+    atomic_store(&pool_counter, 0);
+    for (int i = 0; i < 10000; i++) {
+        assert(worker_pool_submit(pool, pool_spawn, pool) == true);
+    }
+    worker_pool_wait(pool);
+    assert(atomic_load(&pool_counter) == 30000);
+
+    size_t executed = 0;
+    for (size_t i = 0; i < pool->worker_count; i++) {
+        executed += pool->workers[i].executed;
+    }
+    assert(executed == 30000);
+    printf("✓ 线程池执行全部30000个任务\n");
+
+    // 等待之后仍可继续提交
+    atomic_store(&pool_counter, 0);
+    worker_pool_submit(pool, pool_spawn, pool);
+    worker_pool_wait(pool);
+    assert(atomic_load(&pool_counter) == 3);
+    worker_pool_destroy(pool);
+    printf("✓ 线程池可重复等待并正常销毁\n");
+}
+
+static size_t cmp_calls = 0;
+
+int counting_int_cmp(const void *a, const void *b) {
+    cmp_calls++;
+    return int_cmp(a, b);
+}
+
+void add_thousand(void *data, const void *new_value) {
+    (void)new_value;
+    *(int *)data += 1000;
+}
+
+// 测试18：按值查找的过滤器
+void test_filter() {
+    printf("\n=== 测试18：按值查找过滤器 ===\n");
+
+    List *list = init_list(counting_int_cmp, int_free);
+    for (int i = 0; i < 100; i++) {
+        insert_at_tail(list, new_int(i * 2));
+    }
+    assert(enable_filter(list, int_hash) == true);
+
+    // 已有元素一定能找到，一定不存在的键不调用 cmp
+    for (int i = 0; i < 100; i++) {
+        int key = i * 2;
+        assert(filter_may_contain(list, &key) == true);
+        assert(*(int *)search_by_value(list, &key)->data == key);
+    }
+    size_t rejected = 0;
+    for (int i = 0; i < 100; i++) {
+        int key = i * 2 + 1;
+        size_t before = cmp_calls;
+        assert(search_by_value(list, &key) == NULL);
+        if (cmp_calls == before) rejected++;
+    }
+    assert(rejected > 90);
+    printf("✓ 100次未命中查找中%zu次被过滤器直接排除\n", rejected);
+
+    // 删除与更新后计数器同步：删掉的键不再存在，其余键不受影响
+    int key = 10;
+    assert(delete_by_value(list, &key) == true);
+    assert(search_by_value(list, &key) == NULL);
+    key = 12;
+    assert(search_by_value(list, &key) != NULL);
+    assert(update_by_value(list, &key, NULL, add_thousand) == true);
+    assert(search_by_value(list, &key) == NULL);
+    key = 1012;
+    assert(search_by_value_reverse(list, &key) != NULL);
+    printf("✓ 删除 / 更新后过滤器同步\n");
+
+    // 持续增长触发扩容重建，无漏判
+    for (int i = 0; i < 50000; i++) {
+        insert_at_head(list, new_int(100000 + i));
+    }
+    assert(list->filter->capacity >= get_length(list));
+    for (int i = 0; i < 50000; i += 97) {
+        key = 100000 + i;
+        assert(search_by_value(list, &key) != NULL);
+    }
+    size_t lookups = list->filter->lookups;
+    size_t misses = 0;
+    for (int i = 0; i < 10000; i++) {
+        key = -1 - i;
+        if (filter_may_contain(list, &key)) misses++;
+    }
+    assert(list->filter->lookups == lookups + 10000);
+    printf("✓ 扩容到%zu个元素，误判率 %.2f%%\n", get_length(list), misses * 100.0 / 10000);
+    assert(misses < 500);
+
+    // 未命中查找耗时对比
+    List *plain = clone_list(list, int_copy);
+    disable_filter(plain);
+    clock_t start = clock();
+    for (int i = 0; i < 200; i++) {
+        key = -1 - i;
+        search_by_value(plain, &key);
+    }
+    double plain_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (int i = 0; i < 200; i++) {
+        key = -1 - i;
+        search_by_value(list, &key);
+    }
+    double filter_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("200次未命中查找: 无过滤器 %.4f秒, 有过滤器 %.4f秒\n", plain_time, filter_time);
+
+    // 克隆继承过滤器；concat / clear 后状态正确
+    List *copy = clone_list(list, int_copy);
+    assert(copy->filter != NULL);
+    key = 100001;
+    assert(search_by_value(copy, &key) != NULL);
+    assert(concat_lists(plain, copy) == true);
+    assert(search_by_value(copy, &key) == NULL);
+    clear_list(list);
+    assert(filter_may_contain(list, &key) == false);
+    insert_at_tail(list, new_int(key));
+    assert(search_by_value(list, &key) != NULL);
+    printf("✓ 克隆 / 整段移动 / 清空后过滤器正确\n");
+
+    // 反复重算指纹不会把元素重复加入过滤器：删除后键仍被排除；克隆失败时释放已建的过滤器
+    for (int i = 0; i < 300; i++) {
+        enable_fingerprint(list, int_hash);
+    }
+    assert(delete_by_value(list, &key) == true);
+    assert(filter_may_contain(list, &key) == false);
+    insert_at_tail(list, new_int(key));
+    copy_budget = 0;
+    assert(clone_list(list, int_copy_limited) == NULL);
+    printf("✓ 重算指纹后过滤器计数不膨胀，克隆失败不泄漏\n");
+
+    destroy_list(copy);
+    destroy_list(plain);
+    destroy_list(list);
+}
+
+// 有符号整数映射为按无符号比较时顺序不变的排序键
+uint64_t int_sort_key(const void *data) {
+    return (uint64_t)(int64_t)*(int *)data ^ (1ULL << 63);
+}
+
+// 只取高位作为键，用于检验稳定性
+uint64_t int_bucket_key(const void *data) {
+    return (uint64_t)(*(int *)data / 1000000);
+}
+
+const void *str_sort_key(const void *data, size_t *length) {
+    *length = strlen((const char *)data);
+    return data;
+}
+
+// 检查 prev / next 一致且按 cmp 不降序
+void assert_sorted(List *list, int (*cmp)(const void *, const void *)) {
+    size_t count = 0;
+    ListNode *prev = NULL;
+    for (ListNode *node = list->head; node; node = node->next) {
+        assert(node->prev == prev);
+        if (prev) assert(cmp(prev->data, node->data) <= 0);
+        prev = node;
+        count++;
+    }
+    assert(list->tail == prev);
+    assert(count == get_length(list));
+}
+
+// 测试19：基数排序
+void test_radix_sort() {
+    printf("\n=== 测试19：基数排序 ===\n");
+
+    // 整数键：含负数，与归并排序结果一致
+    List *radix = init_list(int_cmp, int_free);
+    enable_fingerprint(radix, int_hash);
+    for (int i = 0; i < 20000; i++) {
+        insert_at_tail(radix, new_int(rand() % 200001 - 100000));
+    }
+    List *merge = clone_list(radix, int_copy);
+    assert(sort_list_by_key(radix, int_sort_key) == true);
+    assert(sort_list(merge) == true);
+    assert_sorted(radix, int_cmp);
+    assert_sorted(merge, int_cmp);
+    assert(compare_lists(radix, merge) == true);
+    assert(get_fingerprint(radix) == recomputed_fingerprint(radix));
+    printf("✓ 整数键基数排序与归并排序结果一致\n");
+
+    // 稳定性：键相同的元素保持原有相对顺序
+    clear_list(radix);
+    for (int i = 0; i < 10000; i++) {
+        insert_at_tail(radix, new_int((i * 7919) % 10 * 1000000 + i));
+    }
+    assert(sort_list_by_key(radix, int_bucket_key) == true);
+    for (ListNode *node = radix->head; node && node->next; node = node->next) {
+        int a = *(int *)node->data;
+        int b = *(int *)node->next->data;
+        assert(a / 1000000 < b / 1000000 || (a / 1000000 == b / 1000000 && a < b));
+    }
+    printf("✓ 基数排序稳定\n");
+
+    // 字节串键：含空串、互为前缀、长公共前缀的键
+    List *strs = init_list(str_cmp, free);
+    char buffer[600];
+    for (int i = 0; i < 5000; i++) {
+        int prefix = (i % 7 == 0) ? 500 : rand() % 4;
+        int length = prefix + rand() % 6;
+        for (int j = 0; j < length; j++) {
+            buffer[j] = j < prefix ? 'a' : (char)('a' + rand() % 3);
+        }
+        buffer[length] = '\0';
+        insert_at_tail(strs, strdup(buffer));
+    }
+    List *strs_merge = clone_list(strs, NULL);
+    assert(sort_list_by_bytes(strs, str_sort_key) == true);
+    assert(sort_list(strs_merge) == true);
+    assert_sorted(strs, str_cmp);
+    assert(compare_lists(strs, strs_merge) == true);
+    printf("✓ 字节串键 MSD 基数排序正确\n");
+
+    // 性能对比
+    clear_list(radix);
+    for (int i = 0; i < 200000; i++) {
+        insert_at_tail(radix, new_int(rand()));
+    }
+    clear_list(merge);
+    copy_list(merge, radix, int_copy);
+    clock_t start = clock();
+    sort_list(merge);
+    double merge_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    sort_list_by_key(radix, int_sort_key);
+    double radix_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    assert(compare_lists(radix, merge) == true);
+    printf("200000个元素: 归并排序 %.4f秒, 基数排序 %.4f秒\n", merge_time, radix_time);
+
+    // 空链表与单元素
+    List *empty = init_list(int_cmp, int_free);
+    assert(sort_list_by_key(empty, int_sort_key) == true);
+    insert_at_tail(empty, new_int(1));
+    assert(sort_list_by_bytes(empty, NULL) == false);
+    assert(sort_list(empty) == true && *(int *)empty->head->data == 1);
+
+    destroy_list(empty);
+    destroy_list(strs_merge);
+    destroy_list(strs);
+    destroy_list(merge);
+    destroy_list(radix);
+}
+
+List *int_list_of(const int *values, size_t count) {
+    List *list = init_list(int_cmp, int_free);
+    for (size_t i = 0; i < count; i++) {
+        insert_at_tail(list, new_int(values[i]));
+    }
+    return list;
+}
+
+void assert_ints(List *list, const int *values, size_t count) {
+    assert(get_length(list) == count);
+    size_t i = 0;
+    ListNode *prev = NULL;
+    for (ListNode *node = list->head; node; node = node->next, i++) {
+        assert(node->prev == prev);
+        assert(*(int *)node->data == values[i]);
+        prev = node;
+    }
+    assert(list->tail == prev && i == count);
+}
+
+// 按计数逐个值核对多重集合运算的结果
+void assert_set_result(List *result, const int *count_a, const int *count_b, int range, int op) {
+    size_t expected_size = 0;
+    int expected[64];
+    for (int v = 0; v < range; v++) {
+        int a = count_a[v], b = count_b[v];
+        int n = op == 0 ? (a > b ? a : b) :
+                op == 1 ? (a < b ? a : b) :
+                op == 2 ? (a > b ? a - b : 0) : abs(a - b);
+        expected[v] = n;
+        expected_size += n;
+    }
+    assert(get_length(result) == expected_size);
+    int prev = -1;
+    for (ListNode *node = result->head; node; node = node->next) {
+        int v = *(int *)node->data;
+        assert(v >= prev);
+        expected[v]--;
+        prev = v;
+    }
+    for (int v = 0; v < range; v++) {
+        assert(expected[v] == 0);
+    }
+}
+
+// 测试20：有序集合运算
+void test_set_operations() {
+    printf("\n=== 测试20：有序集合运算 ===\n");
+
+    const int a_values[] = {1, 2, 2, 3, 5, 7, 7, 7, 9};
+    const int b_values[] = {2, 3, 3, 4, 7, 10};
+    const int union_values[] = {1, 2, 2, 3, 3, 4, 5, 7, 7, 7, 9, 10};
+    const int inter_values[] = {2, 3, 7};
+    const int diff_values[] = {1, 2, 5, 7, 7, 9};
+    const int sym_values[] = {1, 2, 3, 4, 5, 7, 7, 9, 10};
+    const int merge_values[] = {1, 2, 2, 2, 3, 3, 3, 4, 5, 7, 7, 7, 7, 9, 10};
+    size_t na = sizeof(a_values) / sizeof(int), nb = sizeof(b_values) / sizeof(int);
+
+    List *a = int_list_of(a_values, na);
+    List *b = int_list_of(b_values, nb);
+    List *result = union_lists(a, b);
+    assert_ints(result, union_values, sizeof(union_values) / sizeof(int));
+    assert(result->free_data == NULL);
+    destroy_list(result);
+    result = intersect_lists(a, b);
+    assert_ints(result, inter_values, sizeof(inter_values) / sizeof(int));
+    destroy_list(result);
+    result = difference_lists(a, b);
+    assert_ints(result, diff_values, sizeof(diff_values) / sizeof(int));
+    destroy_list(result);
+    result = symmetric_difference_lists(a, b);
+    assert_ints(result, sym_values, sizeof(sym_values) / sizeof(int));
+    destroy_list(result);
+    assert_ints(a, a_values, na);
+    assert_ints(b, b_values, nb);
+    printf("✓ 新建结果的并 / 交 / 差 / 对称差正确，源链表不变\n");
+
+    bool (*inplace[])(List *, List *) = {
+        union_lists_inplace, intersect_lists_inplace, difference_lists_inplace,
+        symmetric_difference_lists_inplace, merge_sorted_lists
+    };
+    const int *inplace_values[] = {union_values, inter_values, diff_values, sym_values, merge_values};
+    size_t inplace_sizes[] = {12, 3, 6, 9, 15};
+    for (int op = 0; op < 5; op++) {
+        List *x = int_list_of(a_values, na);
+        List *y = int_list_of(b_values, nb);
+        enable_fingerprint(x, int_hash);
+        assert(inplace[op](x, y) == true);
+        assert_ints(x, inplace_values[op], inplace_sizes[op]);
+        assert(is_empty(y) && y->head == NULL && y->tail == NULL);
+        assert(get_fingerprint(x) == recomputed_fingerprint(x));
+        destroy_list(x);
+        destroy_list(y);
+    }
+    assert(union_lists_inplace(a, a) == false);
+    printf("✓ 原地运算与归并正确，list2 清空\n");
+
+    // 随机多重集合（含长段同侧元素，触发指数探测）与逐值计数结果比较
+    for (int round = 0; round < 300; round++) {
+        int range = 1 + rand() % 60;
+        int count_a[64] = {0}, count_b[64] = {0};
+        List *x = init_list(int_cmp, int_free);
+        List *y = init_list(int_cmp, int_free);
+        int nx = rand() % 150, ny = rand() % 150;
+        for (int i = 0; i < nx; i++) {
+            int v = rand() % range;
+            if (round % 3 == 0) v = v / 2;
+            count_a[v]++;
+            insert_at_tail(x, new_int(v));
+        }
+        for (int i = 0; i < ny; i++) {
+            int v = rand() % range;
+            if (round % 3 == 1) v = range - 1 - v / 3;
+            count_b[v]++;
+            insert_at_tail(y, new_int(v));
+        }
+        sort_list(x);
+        sort_list(y);
+
+        List *(*fresh[])(List *, List *) = {union_lists, intersect_lists, difference_lists,
+                                            symmetric_difference_lists};
+        for (int op = 0; op < 4; op++) {
+            List *r = fresh[op](x, y);
+            assert_set_result(r, count_a, count_b, range, op);
+            destroy_list(r);
+        }
+        int op = round % 4;
+        assert(inplace[op](x, y) == true);
+        assert_set_result(x, count_a, count_b, range, op);
+        assert(is_empty(y));
+        destroy_list(x);
+        destroy_list(y);
+    }
+    printf("✓ 300组随机多重集合结果正确\n");
+
+    // 规模悬殊时比较次数远小于较长链表的长度
+    List *big = init_list(counting_int_cmp, int_free);
+    List *small = init_list(counting_int_cmp, int_free);
+    for (int i = 0; i < 200000; i++) {
+        insert_at_tail(big, new_int(i * 2));
+    }
+    for (int i = 0; i < 20; i++) {
+        insert_at_tail(small, new_int(i * 20000 + (i % 2)));
+    }
+    cmp_calls = 0;
+    result = intersect_lists(big, small);
+    assert(get_length(result) == 10);
+    printf("200000与20个元素求交集: cmp 调用 %zu 次\n", cmp_calls);
+    assert(cmp_calls < 2000);
+    destroy_list(result);
+
+    cmp_calls = 0;
+    assert(difference_lists_inplace(big, small) == true);
+    assert(get_length(big) == 199990 && is_empty(small));
+    printf("200000与20个元素原地求差集: cmp 调用 %zu 次\n", cmp_calls);
+    assert(cmp_calls < 2000);
+
+    destroy_list(small);
+    destroy_list(big);
+    destroy_list(b);
+    destroy_list(a);
+}
+
+// 检查链表结构完整且内容与 expected 一致
+void assert_same_ints(List *list, List *expected) {
+    assert(get_length(list) == get_length(expected));
+    ListNode *prev = NULL;
+    ListNode *other = expected->head;
+    for (ListNode *node = list->head; node; node = node->next, other = other->next) {
+        assert(node->prev == prev);
+        assert(*(int *)node->data == *(int *)other->data);
+        prev = node;
+    }
+    assert(list->tail == prev && other == NULL);
+}
+
+double time_missing_searches(List *list) {
+    int key = -1;
+    clock_t start = clock();
+    for (int i = 0; i < 50; i++) {
+        search_by_value(list, &key);
+    }
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+// 测试21：链表压缩
+void test_compact_list() {
+    printf("\n=== 测试21：链表压缩 ===\n");
+
+    // 穿插其他分配并按哈希重排，模拟长期增删后节点在堆上分散
+    List *list = init_list(int_cmp, int_free);
+    void *noise[4096] = {NULL};
+    for (int i = 0; i < 100000; i++) {
+        insert_at_tail(list, new_int(i));
+        free(noise[i % 4096]);
+        noise[i % 4096] = malloc(16 + rand() % 64);
+        if (i % 3 == 0) delete_at_head(list);
+    }
+    for (int i = 0; i < 4096; i++) {
+        free(noise[i]);
+    }
+    sort_list_by_key(list, int_hash);
+    List *expected = clone_list(list, int_copy);
+    enable_fingerprint(list, int_hash);
+    uint64_t fingerprint = get_fingerprint(list);
+
+    double scattered = time_missing_searches(list);
+    assert(compact_list(list, 0) == true);
+    double compacted = time_missing_searches(list);
+    assert_same_ints(list, expected);
+    assert(get_fingerprint(list) == fingerprint);
+    for (ListNode *node = list->head; node->next; node = node->next) {
+        assert(node->next == node + 1);
+    }
+    printf("%zu个节点50次未命中查找: 压缩前 %.4f秒, 压缩后 %.4f秒\n",
+           get_length(list), scattered, compacted);
+
+    // 数据一并嵌入：数据紧跟节点，删除时随块释放
+    assert(compact_list(list, sizeof(int)) == true);
+    assert_same_ints(list, expected);
+    for (ListNode *node = list->head; node; node = node->next) {
+        assert((char *)node->data == (char *)node + sizeof(ListNode));
+    }
+    double embedded = time_missing_searches(list);
+    printf("数据嵌入节点旁后50次未命中查找: %.4f秒\n", embedded);
+    int value = 7;
+    assert(update_node(list, list->head, &value, int_update) == true);
+    *(int *)expected->head->data = 7;
+    delete_at_tail(list);
+    delete_at_tail(expected);
+    assert(delete_by_value(list, &value) == true);
+    assert(delete_by_value(expected, &value) == true);
+    insert_at_head(list, new_int(-5));
+    insert_at_head(expected, new_int(-5));
+    assert(compact_list(list, sizeof(int)) == true);
+    assert_same_ints(list, expected);
+    assert(get_fingerprint(list) == recomputed_fingerprint(list));
+    printf("✓ 整体压缩后顺序、内容、指纹不变\n");
+
+    // 增量压缩：每次最多搬迁 1000 个，期间继续删除与插入
+    size_t steps = 0;
+    while (!compact_list_step(list, 1000, 0)) {
+        steps++;
+        ListNode *cursor = list->compact_cursor;
+        if (cursor && steps % 2 == 0) {
+            int removed = *(int *)cursor->data;
+            assert(delete_node(list, cursor) == true);
+            assert(delete_by_value(expected, &removed) == true);
+        }
+        insert_at_tail(list, new_int((int)steps));
+        insert_at_tail(expected, new_int((int)steps));
+    }
+    assert(list->compact_cursor == NULL);
+    assert_same_ints(list, expected);
+    assert(get_fingerprint(list) == recomputed_fingerprint(list));
+    printf("✓ 增量压缩%zu步完成，期间的插入删除不受影响\n", steps + 1);
+
+    // 增量压缩中途原地更新游标所在的节点：节点没有摘除，游标不动，本轮不会跳过它
+    assert(compact_list_step(list, 100, sizeof(int)) == false);
+    ListNode *cursor = list->compact_cursor;
+    int same = *(int *)cursor->data;
+    assert(update_node(list, cursor, &same, int_update) == true);
+    assert(list->compact_cursor == cursor);
+
+    // 增量压缩中途排序：重新开始一轮
+    sort_list(list);
+    sort_list(expected);
+    assert(list->compact_cursor == list->head);
+    while (!compact_list_step(list, 5000, sizeof(int))) {
+    }
+    assert_same_ints(list, expected);
+
+    clear_list(list);
+    assert(compact_list(list, 0) == true);
+    assert(compact_list_step(list, 10, 0) == true);
+
+    destroy_list(expected);
+    destroy_list(list);
+}
+
+// 按逻辑顺序核对内容，并检查逻辑前驱 / 后继互相一致
+void assert_logical_ints(List *list, const int *values, size_t count) {
+    assert(get_length(list) == count);
+    size_t i = 0;
+    ListNode *prev = NULL;
+    for (ListNode *node = get_first_node(list); node; node = get_next_node(list, node), i++) {
+        assert(get_prev_node(list, node) == prev);
+        assert(*(int *)node->data == values[i]);
+        prev = node;
+    }
+    assert(get_last_node(list) == prev && i == count);
+}
+
+// 测试22：O(1) 反转
+void test_lazy_reverse() {
+    printf("\n=== 测试22：O(1) 反转 ===\n");
+
+    // 反转不触碰节点：物理链接不变，逻辑顺序相反
+    int values[] = {1, 2, 3, 4, 5};
+    List *list = int_list_of(values, 5);
+    ListNode *head = list->head;
+    ListNode *second = head->next;
+    assert(reverse_list(list) == true);
+    assert(list->head == head && head->next == second);
+    int reversed[] = {5, 4, 3, 2, 1};
+    assert_logical_ints(list, reversed, 5);
+    assert(*(int *)get_node_at_position(list, 1)->data == 4);
+    assert(*(int *)get_node_at_position_reverse(list, 1)->data == 2);
+    printf("✓ 反转只翻转方向标志，按位置访问遵循逻辑顺序\n");
+
+    // 反转后的插入、删除、移动都按逻辑方向进行
+    insert_at_head(list, new_int(6));           // 6 5 4 3 2 1
+    insert_at_tail(list, new_int(0));           // 6 5 4 3 2 1 0
+    insert_at_position(list, new_int(9), 2);    // 6 5 9 4 3 2 1 0
+    int key = 3;
+    ListNode *three = search_by_value(list, &key);
+    insert_after_node(list, three, new_int(7));  // 6 5 9 4 3 7 2 1 0
+    insert_before_node(list, three, new_int(8)); // 6 5 9 4 8 3 7 2 1 0
+    delete_at_head(list);                       // 5 9 4 8 3 7 2 1 0
+    delete_at_tail(list);                       // 5 9 4 8 3 7 2 1
+    delete_at_position(list, 1);                // 5 4 8 3 7 2 1
+    move_to_head(list, three);                  // 3 5 4 8 7 2 1
+    key = 2;
+    move_to_tail(list, search_by_value(list, &key)); // 3 5 4 8 7 1 2
+    int mixed[] = {3, 5, 4, 8, 7, 1, 2};
+    assert_logical_ints(list, mixed, 7);
+    key = 5;
+    assert(search_by_value_reverse(list, &key) == get_next_node(list, three));
+    printf("✓ 反转后插入、删除、移动、查找按逻辑顺序\n");
+
+    // 落实方向后物理链接即逻辑顺序；再次反转回到原方向
+    assert(materialize_list(list) == true);
+    assert(list->reversed == false);
+    assert_ints(list, mixed, 7);
+    reverse_list(list);
+    reverse_list(list);
+    assert_ints(list, mixed, 7);
+    printf("✓ materialize_list 把逻辑方向落实到 head / next\n");
+
+    // 逻辑指纹：反转后与手工逆序构造的链表一致，即使一方未落实
+    enable_fingerprint(list, int_hash);
+    reverse_list(list);
+    int backwards[] = {2, 1, 7, 8, 4, 5, 3};
+    List *manual = int_list_of(backwards, 7);
+    enable_fingerprint(manual, int_hash);
+    assert(get_fingerprint(list) == get_fingerprint(manual));
+    assert(compare_lists(list, manual) == true);
+    insert_at_head(list, new_int(11));
+    insert_at_head(manual, new_int(11));
+    assert(get_fingerprint(list) == get_fingerprint(manual));
+    materialize_list(list);
+    assert(get_fingerprint(list) == get_fingerprint(manual));
+    printf("✓ 逻辑指纹与比较不受物理方向影响\n");
+
+    // 复制与拼接：两侧方向任意组合都按逻辑顺序接到尾部
+    List *copy = init_list(int_cmp, int_free);
+    insert_at_tail(copy, new_int(100));
+    reverse_list(copy);
+    reverse_list(manual);                       // 3 5 4 8 7 1 2 11
+    assert(copy_list(copy, manual, int_copy) == true);
+    int copied[] = {100, 3, 5, 4, 8, 7, 1, 2, 11};
+    assert_logical_ints(copy, copied, 9);
+    assert(concat_lists(copy, manual) == true);  // 方向相同
+    assert(is_empty(manual) && manual->reversed == false);
+    int tail[] = {200, 201};
+    List *forward = int_list_of(tail, 2);
+    assert(concat_lists(copy, forward) == true); // 方向不同
+    int joined[] = {100, 3, 5, 4, 8, 7, 1, 2, 11, 3, 5, 4, 8, 7, 1, 2, 11, 200, 201};
+    assert_logical_ints(copy, joined, 19);
+    printf("✓ 复制与拼接支持方向不同的链表\n");
+
+    // 排序、集合运算先落实方向，稳定性按逻辑顺序
+    assert(sort_list(copy) == true);
+    int sorted[] = {1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 7, 7, 8, 8, 11, 11, 100, 200, 201};
+    assert_ints(copy, sorted, 19);
+    reverse_list(copy);
+    assert(sort_list_by_key(copy, int_sort_key) == true);
+    assert_ints(copy, sorted, 19);
+    int other[] = {0, 5, 300};
+    List *b = int_list_of(other, 3);
+    reverse_list(copy);
+    reverse_list(copy);
+    assert(union_lists_inplace(copy, b) == true);
+    int merged[] = {0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 7, 7, 8, 8, 11, 11, 100, 200, 201, 300};
+    assert_ints(copy, merged, 21);
+    printf("✓ 排序与集合运算在反转后结果正确\n");
+
+    // 大链表反转为 O(1)
+    List *big = init_list(int_cmp, int_free);
+    for (int i = 0; i < 1000000; i++) {
+        insert_at_tail(big, new_int(i));
+    }
+    clock_t start = clock();
+    for (int i = 0; i < 1000; i++) {
+        reverse_list(big);
+    }
+    double elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    assert(big->reversed == false);
+    printf("%zu个节点反转1000次: %.6f秒\n", get_length(big), elapsed);
+
+    destroy_list(big);
+    destroy_list(b);
+    destroy_list(forward);
+    destroy_list(copy);
+    destroy_list(manual);
+    destroy_list(list);
+}
+
+typedef struct {
+    int producer;
+    int seq;
+    char owner[16];
+} ShmTask;
+
+int shm_task_cmp(const void *a, const void *b) {
+    const ShmTask *x = a;
+    const ShmTask *y = b;
+    return x->producer != y->producer ? x->producer - y->producer : x->seq - y->seq;
+}
+
+// 挂接已有的共享链表并插入 count 个任务
+void shm_produce(const char *name, int producer, int count) {
+    ShmList *list = shm_list_attach(name);
+    assert(list != NULL);
+    for (int i = 0; i < count; i++) {
+        ShmTask task = {producer, i, "worker"};
+        assert(shm_list_insert_tail(list, &task, sizeof(task)) != NULL);
+    }
+    shm_list_detach(list);
+}
+
+// 测试23：共享内存链表
+void test_shm_list() {
+    printf("\n=== 测试23：共享内存链表 ===\n");
+
+    char name[64];
+    snprintf(name, sizeof(name), "/general_list_test_%d", (int)getpid());
+    shm_unlink(name);
+
+    ShmList *a = shm_list_create(name, 20000, sizeof(ShmTask));
+    assert(a != NULL);
+    assert(shm_list_create(name, 10, sizeof(ShmTask)) == NULL);
+
+    // 同一进程内再挂接一次：映射地址不同，通过偏移看到同一个链表
+    ShmList *b = shm_list_attach(name);
+    assert(b != NULL && (void *)b->header != (void *)a->header);
+    ShmTask first = {0, 0, "parent"};
+    shm_list_insert_tail(a, &first, sizeof(first));
+    assert(shm_list_size(b) == 1);
+    shm_list_lock(b);
+    ShmTask *seen = shm_node_data(shm_list_first(b));
+    assert(seen->producer == 0 && strcmp(seen->owner, "parent") == 0);
+    seen->seq = 42;                             // 直接在段内修改
+    shm_list_unlock(b);
+    assert(((ShmTask *)shm_node_data(shm_list_first(a)))->seq == 42);
+    assert(shm_list_pop_head(a, NULL, 0) == sizeof(ShmTask));
+    assert(shm_list_size(b) == 0 && shm_list_first(b) == NULL);
+    printf("✓ 两个映射地址不同的句柄共享同一个链表\n");
+
+    // 零拷贝插入：在段内分配节点、直接写入后挂入
+    ShmNode *node = shm_list_alloc(a, sizeof(ShmTask));
+    ShmTask *slot = shm_node_data(node);
+    slot->producer = 0;
+    slot->seq = 1;
+    strcpy(slot->owner, "zero-copy");
+    assert(shm_list_attach_head(a, node) == true);
+    assert(shm_list_alloc(a, sizeof(ShmTask) + 1) == NULL);
+    printf("✓ 段内分配节点后零拷贝挂入\n");
+
+    // 多进程并发插入：每个生产者内部顺序保持
+    enum { PRODUCERS = 3, PER_PRODUCER = 5000 };
+    pid_t pids[PRODUCERS - 1];
+    for (int p = 1; p < PRODUCERS; p++) {
+        pids[p - 1] = fork();
+        assert(pids[p - 1] >= 0);
+        if (pids[p - 1] == 0) {
+            shm_produce(name, p, PER_PRODUCER);
+            _exit(0);
+        }
+    }
+    shm_produce(name, PRODUCERS, PER_PRODUCER);
+    for (int p = 0; p < PRODUCERS - 1; p++) {
+        int status;
+        waitpid(pids[p], &status, 0);
+        assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+    assert(shm_list_size(a) == 1 + PRODUCERS * PER_PRODUCER);
+
+    int next_seq[PRODUCERS + 1] = {0};
+    size_t count = 0;
+    shm_list_lock(b);
+    ShmNode *prev = NULL;
+    for (ShmNode *n = shm_list_first(b); n; n = shm_list_next(b, n), count++) {
+        assert(shm_list_prev(b, n) == prev);
+        ShmTask *task = shm_node_data(n);
+        if (task->producer > 0) {
+            assert(task->seq == next_seq[task->producer]++);
+        }
+        prev = n;
+    }
+    assert(shm_list_last(b) == prev);
+    shm_list_unlock(b);
+    assert(count == 1 + PRODUCERS * PER_PRODUCER);
+    printf("✓ %d个进程并发插入%d个任务，各自顺序保持\n", PRODUCERS, PRODUCERS * PER_PRODUCER);
+
+    // 子进程按值查找并删除，父进程立即可见；释放的槽位被复用
+    size_t free_before = shm_list_free_slots(a);
+    pid_t pid = fork();
+    assert(pid >= 0);
+    if (pid == 0) {
+        ShmList *child = shm_list_attach(name);
+        shm_list_lock(child);
+        for (int i = 0; i < PER_PRODUCER; i += 2) {
+            ShmTask key = {2, i, ""};
+            ShmNode *found = shm_list_search(child, &key, shm_task_cmp);
+            if (!found || !shm_list_delete(child, found)) _exit(1);
+        }
+        shm_list_unlock(child);
+        shm_list_detach(child);
+        _exit(0);
+    }
+    int status;
+    waitpid(pid, &status, 0);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    assert(shm_list_size(a) == 1 + PRODUCERS * PER_PRODUCER - PER_PRODUCER / 2);
+    assert(shm_list_free_slots(a) == free_before + PER_PRODUCER / 2);
+    ShmTask key = {2, 2, ""};
+    shm_list_lock(a);
+    assert(shm_list_search(a, &key, shm_task_cmp) == NULL);
+    key.seq = 3;
+    assert(shm_list_search(a, &key, shm_task_cmp) != NULL);
+    shm_list_unlock(a);
+    printf("✓ 其他进程的删除立即可见，槽位回收复用\n");
+
+    // 持锁进程崩溃：下一个加锁者接管并修复链表
+    pid = fork();
+    assert(pid >= 0);
+    if (pid == 0) {
+        ShmList *child = shm_list_attach(name);
+        shm_list_lock(child);
+        child->header->tail = 0;                // 模拟修改到一半时崩溃
+        child->header->size = 0;
+        _exit(0);
+    }
+    waitpid(pid, &status, 0);
+    assert(shm_list_lock(a) == true);
+    assert(a->header->size == 1 + PRODUCERS * PER_PRODUCER - PER_PRODUCER / 2);
+    assert(shm_list_last(a) != NULL && shm_list_next(a, shm_list_last(a)) == NULL);
+    shm_list_unlock(a);
+    printf("✓ 持锁进程崩溃后锁可恢复，链表按 next 链修复\n");
+
+    // 槽位耗尽
+    while (shm_list_insert_tail(a, &first, sizeof(first))) {
+    }
+    assert(shm_list_free_slots(a) == 0);
+    assert(shm_list_size(a) == 20000);
+
+    shm_list_detach(b);
+    shm_list_destroy(a);
+    assert(shm_list_attach(name) == NULL);
+}
+
+bool is_multiple_of_five(const void *data) {
+    return *(const int *)data % 5 == 0;
+}
+
+// -1 无法序列化，用于制造日志写入失败
+size_t failing_serialize(const void *data, void *buf, size_t capacity) {
+    if (*(const int *)data == -1) return SIZE_MAX;
+    return int_serialize(data, buf, capacity);
+}
+
+// 关闭日志并重新打开到新链表，返回回放得到的链表
+List *reopen_journal(List *list, const char *path, size_t group_records) {
+    destroy_list(list);
+    List *replayed = init_list(int_cmp, int_free);
+    assert(list_journal_open(replayed, path, int_serialize, int_deserialize, group_records, 0) == true);
+    return replayed;
+}
+
+// 测试24：预写日志
+void test_journal() {
+    printf("\n=== 测试24：预写日志 ===\n");
+
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/general_list_journal_%d", (int)getpid());
+    unlink(path);
+
+    // 各类修改都能回放
+    List *list = init_list(int_cmp, int_free);
+    assert(list_journal_open(list, path, int_serialize, int_deserialize, 1, 0) == true);
+    for (int i = 0; i < 10; i++) {
+        insert_at_tail(list, new_int(i));
+    }
+    insert_at_head(list, new_int(-1));
+    insert_at_position(list, new_int(100), 5);
+    int key = 7;
+    ListNode *seven = search_by_value(list, &key);
+    insert_after_node(list, seven, new_int(70));
+    insert_before_node(list, seven, new_int(69));
+    delete_at_head(list);
+    delete_at_tail(list);
+    key = 3;
+    delete_by_value(list, &key);
+    delete_at_position(list, 2);
+    delete_node(list, seven);
+    key = 100;
+    int value = 101;
+    update_by_value(list, &key, &value, int_update);
+    value = 55;
+    update_if(list, is_multiple_of_five, &value, int_update);
+    update_node(list, get_node_at_position(list, 1), &value, int_update);
+    replace_node_data(list, get_last_node(list), new_int(88));
+    key = 70;
+    move_to_head(list, search_by_value(list, &key));
+    reverse_list(list);
+    List *other = init_list(int_cmp, int_free);
+    insert_at_tail(other, new_int(500));
+    insert_at_tail(other, new_int(501));
+    concat_lists(list, other);
+    insert_at_tail(other, new_int(600));
+    copy_list(list, other, int_copy);
+    // 流水线 update 阶段按逻辑位置记录（反转状态下同样正确）
+    reverse_list(list);
+    ListPipeline bump = list_pipe(list);
+    value = 1;
+    assert(pipe_count(pipe_update(&bump, is_multiple_of_five, &value, int_update)) == get_length(list));
+    List *expected = clone_list(list, int_copy);
+    list = reopen_journal(list, path, 1);
+    assert(compare_lists(list, expected) == true);
+    destroy_list(expected);
+    printf("✓ 插入、删除、更新、移动、反转、拼接、复制、流水线更新都能从日志回放\n");
+
+    // 随机修改与普通链表对照
+    List *mirror = clone_list(list, int_copy);
+    for (int i = 0; i < 3000; i++) {
+        int op = rand() % 6;
+        int size = (int)get_length(list);
+        int v = rand() % 100;
+        if (op <= 1 || size == 0) {
+            int position = size ? rand() % (size + 1) : 0;
+            insert_at_position(list, new_int(v), position);
+            insert_at_position(mirror, new_int(v), position);
+        } else if (op == 2) {
+            int position = rand() % size;
+            delete_at_position(list, position);
+            delete_at_position(mirror, position);
+        } else if (op == 3) {
+            delete_by_value(list, &v);
+            delete_by_value(mirror, &v);
+        } else if (op == 4) {
+            int new_value = rand() % 100;
+            update_by_value(list, &v, &new_value, int_update);
+            update_by_value(mirror, &v, &new_value, int_update);
+        } else {
+            reverse_list(list);
+            reverse_list(mirror);
+        }
+    }
+    list = reopen_journal(list, path, 1);
+    assert(compare_lists(list, mirror) == true);
+    printf("✓ 3000次随机修改回放后与对照链表一致\n");
+
+    // 排序后日志被快照重写；启动时回放记录过多也会自动压缩
+    sort_list(list);
+    sort_list(mirror);
+    assert(list->journal->records == get_length(list));
+    clear_list(list);
+    clear_list(mirror);
+    list->journal->compact_at = SIZE_MAX;     // 关闭运行中的自动压缩，只验证启动时的压缩
+    for (int i = 0; i < 300; i++) {
+        insert_at_tail(list, new_int(i));
+        delete_at_head(list);
+    }
+    insert_at_tail(list, new_int(1));
+    insert_at_tail(mirror, new_int(1));
+    list = reopen_journal(list, path, 1);
+    assert(compare_lists(list, mirror) == true);
+    assert(list->journal->records == 1);
+    printf("✓ 排序与启动时的压缩用快照重写日志\n");
+
+    // 末尾写了一半的记录被截掉
+    list_journal_close(list);
+    FILE *file = fopen(path, "ab");
+    fwrite("\x00\x05\x00\x00", 1, 4, file);
+    fclose(file);
+    list = reopen_journal(list, path, 1);
+    assert(compare_lists(list, mirror) == true);
+    insert_at_tail(list, new_int(2));
+    insert_at_tail(mirror, new_int(2));
+    list = reopen_journal(list, path, 1);
+    assert(compare_lists(list, mirror) == true);
+    printf("✓ 崩溃时写了一半的尾部记录在回放时截掉\n");
+
+    // 有墓碑时拼接按存活长度记录插入位置
+    enable_deferred_delete(list, 0);
+    insert_at_tail(list, new_int(3));
+    insert_at_tail(mirror, new_int(3));
+    delete_at_head(list);
+    delete_at_head(mirror);
+    List *tail = init_list(int_cmp, int_free);
+    insert_at_tail(tail, new_int(4));
+    insert_at_tail(tail, new_int(5));
+    assert(list->tombstones == 1 && concat_lists(list, tail) == true);
+    insert_at_tail(mirror, new_int(4));
+    insert_at_tail(mirror, new_int(5));
+    destroy_list(tail);
+    list = reopen_journal(list, path, 1);
+    assert(compare_lists(list, mirror) == true);
+    printf("✓ 有墓碑时拼接的日志位置正确\n");
+
+    // 组提交：未提交的一组在进程崩溃时丢失，已提交的保留
+    pid_t pid = fork();
+    assert(pid >= 0);
+    if (pid == 0) {
+        List *child = init_list(int_cmp, int_free);
+        list_journal_open(child, path, int_serialize, int_deserialize, 1000, 0);
+        for (int i = 0; i < 10; i++) {
+            insert_at_tail(child, new_int(1000 + i));
+        }
+        list_journal_commit(child);
+        for (int i = 0; i < 5; i++) {
+            insert_at_tail(child, new_int(2000 + i));
+        }
+        _exit(0);
+    }
+    int status;
+    waitpid(pid, &status, 0);
+    for (int i = 0; i < 10; i++) {
+        insert_at_tail(mirror, new_int(1000 + i));
+    }
+    destroy_list(list);
+    list = init_list(int_cmp, int_free);
+    assert(list_journal_open(list, path, int_serialize, int_deserialize, 64, 0) == true);
+    assert(compare_lists(list, mirror) == true);
+    printf("✓ 已提交的组在崩溃后保留，未提交的组丢失\n");
+
+    // 空闲后的一组：没有新记录时由 list_journal_poll 在等待时间到达后提交
+    clear_list(list);
+    list_journal_close(list);
+    assert(list_journal_open(list, path, int_serialize, int_deserialize, 1000, 2000) == true);
+    assert(list_journal_poll_timeout(list) == -1);
+    size_t idle_commits = list->journal->commits;
+    insert_at_tail(list, new_int(1));
+    insert_at_tail(list, new_int(2));
+    int timeout = list_journal_poll_timeout(list);
+    assert(timeout >= 0 && timeout <= 2);
+    assert(list->journal->pending == 2);
+    usleep(3000);
+    assert(list_journal_poll_timeout(list) == 0);
+    assert(list_journal_poll(list) == true);
+    assert(list->journal->pending == 0 && list->journal->commits == idle_commits + 1);
+    assert(list_journal_poll(list) == false && list_journal_poll_timeout(list) == -1);
+    printf("✓ 空闲时轮询按等待时间提交最后一组\n");
+
+    // 序列化失败后日志停止记录；压缩用快照重建日志后恢复记录
+    List *failing = init_list(int_cmp, int_free);
+    expected = init_list(int_cmp, int_free);
+    unlink(path);
+    assert(list_journal_open(failing, path, failing_serialize, int_deserialize, 1, 0) == true);
+    insert_at_tail(failing, new_int(1));
+    insert_at_tail(failing, new_int(-1));
+    assert(failing->journal->failed == true);
+    insert_at_tail(failing, new_int(2));
+    int unserializable = -1;
+    assert(delete_by_value(failing, &unserializable) == true);
+    assert(list_journal_commit(failing) == false);
+    assert(list_journal_compact(failing) == true && failing->journal->failed == false);
+    insert_at_tail(failing, new_int(3));
+    for (int i = 1; i <= 3; i++) {
+        insert_at_tail(expected, new_int(i));
+    }
+    failing = reopen_journal(failing, path, 1);
+    assert(compare_lists(failing, expected) == true);
+    destroy_list(failing);
+    printf("✓ 日志失效后压缩恢复记录\n");
+
+    // 运行中自动压缩：反复插入删除，日志记录数保持在链表长度的常数倍内；
+    // 压缩可能发生在拼接等多条记录的操作中途，回放结果仍与链表一致
+    unlink(path);
+    List *churn = init_list(int_cmp, int_free);
+    assert(list_journal_open(churn, path, int_serialize, int_deserialize, 8, 0) == true);
+    clear_list(expected);
+    for (int i = 0; i < 100; i++) {
+        insert_at_tail(churn, new_int(i));
+        insert_at_tail(expected, new_int(i));
+    }
+    size_t max_records = 0;
+    for (int round = 0; round < 5000; round++) {
+        insert_at_head(churn, new_int(-round - 2));
+        delete_at_head(churn);
+        if (round % 500 == 0) {
+            List *batch = init_list(int_cmp, int_free);
+            for (int i = 0; i < 20; i++) {
+                insert_at_tail(batch, new_int(1000 + i));
+            }
+            assert(concat_lists(churn, batch) == true);
+            destroy_list(batch);
+            for (int i = 0; i < 20; i++) {
+                delete_at_tail(churn);
+            }
+        }
+        if (churn->journal->records > max_records) max_records = churn->journal->records;
+    }
+    assert(max_records <= 2 * (get_length(churn) + 20) + 64 + 8 + 20);
+    churn = reopen_journal(churn, path, 8);
+    assert(compare_lists(churn, expected) == true);
+    assert(churn->journal->records <= max_records);
+    destroy_list(churn);
+    destroy_list(expected);
+    printf("✓ 运行中自动压缩，日志记录数最多 %zu 条\n", max_records);
+
+    // 无法应用的记录（损坏的日志中位置越界）回放时跳过，反序列化出的数据被释放
+    unlink(path);
+    List *stray = init_list(int_cmp, int_free);
+    assert(list_journal_open(stray, path, int_serialize, int_deserialize, 1, 0) == true);
+    insert_at_tail(stray, new_int(1));
+    int stray_value = 5;
+    list_journal_record(stray, JOURNAL_INSERT, 9, NULL, &stray_value);
+    list_journal_record(stray, JOURNAL_UPDATE, 9, NULL, &stray_value);
+    list_journal_record(stray, JOURNAL_UPDATE_KEY, -1, &stray_value, &stray_value);
+    stray = reopen_journal(stray, path, 1);
+    assert(get_length(stray) == 1 && *(int *)get_first_node(stray)->data == 1);
+    destroy_list(stray);
+    printf("✓ 无法应用的记录回放时跳过且不泄漏\n");
+
+    // 组提交摊薄 fdatasync：对比每条提交与每 256 条提交的单次修改耗时
+    size_t groups[] = {1, 256};
+    for (int g = 0; g < 2; g++) {
+        clear_list(list);
+        list_journal_close(list);
+        assert(list_journal_open(list, path, int_serialize, int_deserialize, groups[g], 0) == true);
+        size_t commits = list->journal->commits;
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (int i = 0; i < 2048; i++) {
+            insert_at_tail(list, new_int(i));
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double micros = ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / 1e3 / 2048;
+        assert(list->journal->commits - commits == 2048 / groups[g]);
+        printf("每%zu条记录提交一次: 单次插入 %.2f微秒\n", groups[g], micros);
+    }
+
+    destroy_list(list);
+    destroy_list(mirror);
+    destroy_list(other);
+    unlink(path);
+}
+
+// 流水线回调：ctx 为计数器时统计调用次数
+bool pipe_is_even(const void *data, void *ctx) {
+    if (ctx) (*(size_t *)ctx)++;
+    return *(const int *)data % 2 == 0;
+}
+
+bool pipe_below(const void *data, void *ctx) {
+    return *(const int *)data < *(const int *)ctx;
+}
+
+void *pipe_square_new(void *data, void *ctx) {
+    (void)ctx;
+    int value = *(int *)data;
+    return new_int(value * value);
+}
+
+bool pipe_multiple_of_seven(const void *data, void *ctx) {
+    (void)ctx;
+    return *(const int *)data % 7 == 0;
+}
+
+typedef struct {
+    size_t count;
+    int *first;
+} ReportSink;
+
+void report_sink(void *data, void *ctx) {
+    ReportSink *report = ctx;
+    if (!report->first) report->first = data;
+    report->count++;
+}
+
+bool is_multiple_of_three(const void *data) {
+    return *(const int *)data % 3 == 0;
+}
+
+void add_thousand_update(void *data, const void *new_value) {
+    *(int *)data += *(const int *)new_value;
+}
+
+// 测试25：惰性流水线
+void test_pipeline() {
+    printf("\n=== 测试25：惰性流水线 ===\n");
+
+    List *list = init_list(int_cmp, int_free);
+    for (int i = 0; i < 100; i++) {
+        insert_at_tail(list, new_int(i));
+    }
+
+    // filter + limit：达到上限后立即停止，不再调用谓词
+    size_t calls = 0;
+    ListPipeline pipe = list_pipe(list);
+    assert(pipe_count(pipe_limit(pipe_filter(&pipe, pipe_is_even, &calls), 5)) == 5);
+    assert(calls == 9);
+    assert(pipe_count(&pipe) == 5 && calls == 18);  // 可重复执行
+    printf("✓ filter + limit 在第5个元素后提前结束（谓词只调用9次）\n");
+
+    // take_while + map + collect：结果进入新链表，无中间链表
+    int bound = 10;
+    ListPipeline squares = list_pipe(list);
+    pipe_map(pipe_filter(pipe_take_while(&squares, pipe_below, &bound), pipe_is_even, NULL),
+             pipe_square_new, NULL);
+    List *out = init_list(int_cmp, int_free);
+    assert(pipe_collect(&squares, out) == true);
+    int expected_squares[] = {0, 4, 16, 36, 64};
+    assert_ints(out, expected_squares, 5);
+    printf("✓ take_while + filter + map 收集到新链表\n");
+
+    // find_first 遵循逻辑顺序，反转后从尾部开始
+    ListPipeline first = list_pipe(list);
+    pipe_filter(&first, pipe_is_even, NULL);
+    assert(*(int *)pipe_find_first(&first) == 0);
+    reverse_list(list);
+    assert(*(int *)pipe_find_first(&first) == 98);
+    reverse_list(list);
+    ListPipeline none = list_pipe(list);
+    assert(pipe_find_first(pipe_take_while(&none, pipe_below, &(int){0})) == NULL);
+    assert(pipe_count(pipe_limit(&none, 0)) == 0);
+    printf("✓ find_first 按逻辑顺序返回第一个结果\n");
+
+    // 阶段数超过上限时终结操作失败
+    ListPipeline full = list_pipe(list);
+    for (int i = 0; i <= PIPE_MAX_STAGES; i++) {
+        pipe_filter(&full, pipe_is_even, NULL);
+    }
+    assert(full.overflow == true && pipe_collect(&full, out) == false);
+
+    // 报表：更新 + 计数 + 查找，三次遍历 vs 一次融合遍历
+    // 两个链表交替构建后按哈希重排，节点在堆上同样分散
+    List *big = init_list(int_cmp, int_free);
+    List *copy = init_list(int_cmp, int_free);
+    for (int i = 0; i < 1000000; i++) {
+        insert_at_tail(big, new_int(i));
+        insert_at_tail(copy, new_int(i));
+    }
+    sort_list_by_key(big, int_hash);
+    sort_list_by_key(copy, int_hash);
+    // 两边都维护指纹和过滤器：update 阶段须与 update_if 一样维护它们
+    enable_fingerprint(big, int_hash);
+    enable_fingerprint(copy, int_hash);
+    enable_filter(big, int_hash);
+    enable_filter(copy, int_hash);
+
+    int delta = 1000;
+    clock_t start = clock();
+    update_if(big, is_multiple_of_three, &delta, add_thousand_update);
+    size_t count = 0;
+    for (ListNode *node = big->head; node; node = node->next) {
+        if (*(int *)node->data % 7 == 0) count++;
+    }
+    ListNode *found = big->head;
+    while (*(int *)found->data % 7 != 0) {
+        found = found->next;
+    }
+    double three_pass = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    ReportSink report = {0, NULL};
+    ListPipeline fused = list_pipe(copy);
+    pipe_filter(pipe_update(&fused, is_multiple_of_three, &delta, add_thousand_update), pipe_multiple_of_seven, NULL);
+    pipe_for_each(&fused, report_sink, &report);
+    double one_pass = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    assert(report.count == count && *report.first == *(int *)found->data);
+    assert(get_fingerprint(big) == get_fingerprint(copy) && compare_lists(big, copy) == true);
+    for (int i = 0; i < 3000; i += 3) {
+        int updated = i + 1000;
+        assert(filter_may_contain(copy, &updated));
+    }
+    printf("%zu个元素 更新+计数+查找: 三次遍历 %.4f秒, 融合遍历 %.4f秒\n",
+           get_length(big), three_pass, one_pass);
+
+    destroy_list(copy);
+    destroy_list(big);
+    destroy_list(out);
+    destroy_list(list);
+}
+
+// 批量比较：先把分散的数据读入连续数组，比较循环可由编译器向量化
+static size_t batch_calls = 0;
+
+uint64_t int_batch_cmp(const void *key, const void *const *data, size_t count) {
+    batch_calls++;
+    int k = *(const int *)key;
+    int values[LIST_BATCH_SIZE];
+    for (size_t i = 0; i < count; i++) {
+        values[i] = *(const int *)data[i];
+    }
+    uint64_t mask = 0;
+    for (size_t i = 0; i < count; i++) {
+        mask |= (uint64_t)(values[i] == k) << i;
+    }
+    return mask;
+}
+
+// 测试26：批量比较
+void test_batch_cmp() {
+    printf("\n=== 测试26：批量比较 ===\n");
+
+    // 0..99 之后再接一份 0..99：按值查找返回第一个 / 最后一个匹配
+    List *list = init_list(int_cmp, int_free);
+    for (int i = 0; i < 200; i++) {
+        insert_at_tail(list, new_int(i % 100));
+    }
+    set_batch_cmp(list, int_batch_cmp);
+    int key = 37;
+    batch_calls = 0;
+    ListNode *found = search_by_value(list, &key);
+    assert(found == get_node_at_position(list, 37));
+    assert(batch_calls == 37 / LIST_BATCH_SIZE + 1);
+    assert(search_by_value_reverse(list, &key) == get_node_at_position(list, 137));
+    key = 1000;
+    batch_calls = 0;
+    assert(search_by_value(list, &key) == NULL);
+    assert(batch_calls == (200 + LIST_BATCH_SIZE - 1) / LIST_BATCH_SIZE);
+    printf("✓ 查找按批比较，返回第一个匹配（200个元素未命中只调用%zu次）\n", batch_calls);
+
+    // 反转后按逻辑方向收集
+    reverse_list(list);
+    key = 99;
+    assert(search_by_value(list, &key) == get_node_at_position(list, 0));
+    assert(search_by_value_reverse(list, &key) == get_node_at_position(list, 100));
+    reverse_list(list);
+
+    // 删除与更新也走批量比较
+    key = 99;
+    assert(delete_by_value(list, &key) == true);
+    assert(*(int *)get_node_at_position(list, 99)->data == 0);
+    key = 50;
+    int value = -50;
+    assert(update_by_value(list, &key, &value, int_update) == true);
+    assert(*(int *)get_node_at_position(list, 50)->data == -50);
+    assert(*(int *)get_node_at_position(list, 149)->data == 50);
+    List *clone = clone_list(list, int_copy);
+    assert(clone->batch_cmp == int_batch_cmp);
+    printf("✓ 反转、删除、更新、克隆与批量比较配合正确\n");
+
+    // 耗时：逐个 cmp vs 批量比较（整数比较本身很便宜，遍历主要受节点间指针追逐限制）
+    int sizes[] = {10000, 1000000};
+    List *big = NULL;
+    for (int s = 0; s < 2; s++) {
+        big = init_list(int_cmp, int_free);
+        for (int i = 0; i < sizes[s]; i++) {
+            insert_at_tail(big, new_int(i));
+        }
+        compact_list(big, sizeof(int));
+        int rounds = 20000000 / sizes[s];
+        key = -1;
+        clock_t start = clock();
+        for (int i = 0; i < rounds; i++) {
+            search_by_value(big, &key);
+        }
+        double single = (double)(clock() - start) / CLOCKS_PER_SEC;
+        set_batch_cmp(big, int_batch_cmp);
+        start = clock();
+        for (int i = 0; i < rounds; i++) {
+            search_by_value(big, &key);
+        }
+        double batched = (double)(clock() - start) / CLOCKS_PER_SEC;
+        printf("%zu个元素%d次未命中查找: 逐个比较 %.4f秒, 批量比较 %.4f秒\n",
+               get_length(big), rounds, single, batched);
+        if (s == 0) destroy_list(big);
+    }
+
+    destroy_list(big);
+    destroy_list(clone);
+    destroy_list(list);
+}
+
+// 测试27：延迟删除
+void test_deferred_delete() {
+    printf("\n=== 测试27：延迟删除 ===\n");
+
+    // 删除只打墓碑：遍历中删除当前节点后仍可从它继续前进
+    List *list = init_list(int_cmp, int_free);
+    for (int i = 0; i < 10; i++) {
+        insert_at_tail(list, new_int(i));
+    }
+    assert(enable_deferred_delete(list, 0) == true);
+    for (ListNode *node = get_first_node(list); node; ) {
+        ListNode *next = get_next_node(list, node);
+        if (*(int *)node->data % 2 == 1) {
+            assert(delete_node(list, node) == true);
+            assert(is_tombstone(node) && get_next_node(list, node) == next);
+        }
+        node = next;
+    }
+    int evens[] = {0, 2, 4, 6, 8};
+    assert_logical_ints(list, evens, 5);
+    assert(list->size == 10 && list->tombstones == 5);
+    printf("✓ 遍历中删除不影响后继，遍历跳过墓碑\n");
+
+    // 查找、按位置访问、头尾删除都跳过墓碑
+    int key = 3;
+    assert(search_by_value(list, &key) == NULL);
+    assert(delete_by_value(list, &key) == false);
+    key = 4;
+    assert(*(int *)search_by_value_reverse(list, &key)->data == 4);
+    assert(*(int *)get_node_at_position(list, 1)->data == 2);
+    assert(*(int *)get_node_at_position_reverse(list, 1)->data == 6);
+    ListNode *dead = list->head->next;
+    assert(is_tombstone(dead) && delete_node(list, dead) == false);
+    int value = 100;
+    assert(update_node(list, dead, &value, int_update) == false);
+    assert(delete_at_head(list) == true && delete_at_tail(list) == true);
+    assert(insert_at_position(list, new_int(3), 1) != NULL);
+    int middle[] = {2, 3, 4, 6};
+    assert_logical_ints(list, middle, 4);
+    reverse_list(list);
+    int reversed[] = {6, 4, 3, 2};
+    assert_logical_ints(list, reversed, 4);
+    reverse_list(list);
+
+    List *copy = clone_list(list, int_copy);
+    assert(compare_lists(list, copy) == true && copy->size == 4);
+    printf("✓ 查找、按位置访问、插入、反转、克隆、比较都只看存活元素\n");
+
+    // 手动清理：一趟摘下全部墓碑
+    assert(purge_tombstones(list) == 7);
+    assert(list->size == 4 && list->tombstones == 0);
+    assert_logical_ints(list, middle, 4);
+    assert(purge_tombstones(list) == 0);
+    printf("✓ purge_tombstones 批量摘链释放\n");
+
+    // 按比例自动清理：墓碑超过 size 的一半时清理
+    enable_deferred_delete(copy, 0.5);
+    for (int i = 0; i < 20; i++) {
+        insert_at_tail(copy, new_int(i));
+    }
+    for (int i = 0; i < 12; i++) {
+        delete_at_head(copy);
+    }
+    assert(get_length(copy) == 12 && copy->tombstones == 12);
+    assert(*(int *)get_first_node(copy)->data == 8);
+    delete_at_head(copy);
+    assert(copy->size == 12 && copy->tombstones == 1);  // 刚删除的节点保留到下次清理
+    delete_at_head(copy);
+    disable_deferred_delete(copy);
+    assert(copy->tombstones == 0 && copy->size == 10);
+    assert(delete_at_head(copy) == true && copy->size == 9);
+    printf("✓ 超过比例自动清理，关闭时清理剩余墓碑\n");
+
+    // 自动清理时可从刚删除的节点继续遍历
+    List *walk = init_list(int_cmp, int_free);
+    enable_deferred_delete(walk, 0.1);
+    for (int i = 0; i < 100; i++) {
+        insert_at_tail(walk, new_int(i));
+    }
+    int visited = 0;
+    for (ListNode *node = get_first_node(walk); node; node = get_next_node(walk, node)) {
+        assert(*(int *)node->data == visited++);
+        delete_node(walk, node);
+    }
+    assert(visited == 100 && get_length(walk) == 0 && walk->tombstones <= 1);
+    destroy_list(walk);
+    printf("✓ 边遍历边删除时自动清理不释放当前节点\n");
+
+    // 排序前先清理；清空重置墓碑
+    enable_deferred_delete(list, 0);
+    delete_at_position(list, 1);
+    assert(sort_list(list) == true && list->tombstones == 0 && list->size == 3);
+    delete_at_head(list);
+    clear_list(list);
+    assert(is_empty(list) && list->tombstones == 0);
+
+    // 耗时：遍历中删除一半元素，立即摘链 vs 打墓碑后一次清理
+    int count = 1000000;
+    double elapsed[2];
+    for (int deferred = 0; deferred < 2; deferred++) {
+        List *big = init_list(int_cmp, int_free);
+        for (int i = 0; i < count; i++) {
+            insert_at_tail(big, new_int(i));
+        }
+        if (deferred) enable_deferred_delete(big, 0);
+        clock_t start = clock();
+        for (ListNode *node = get_first_node(big); node; ) {
+            ListNode *next = get_next_node(big, node);
+            if (*(int *)node->data % 2 == 0) delete_node(big, node);
+            node = next;
+        }
+        purge_tombstones(big);
+        elapsed[deferred] = (double)(clock() - start) / CLOCKS_PER_SEC;
+        assert(get_length(big) == (size_t)count / 2 && big->size == (size_t)count / 2);
+        destroy_list(big);
+    }
+    printf("%d个元素删除一半: 立即摘链 %.4f秒, 墓碑+批量清理 %.4f秒\n", count, elapsed[0], elapsed[1]);
+
+    destroy_list(copy);
+    destroy_list(list);
+}
+
+// 自适应链表的内容与参照数组一致（经游标遍历，同时检查按位置读取）
+void assert_adaptive_ints(AdaptiveList *list, const int *values, size_t count) {
+    assert(adaptive_get_length(list) == count);
+    AdaptiveCursor cursor = adaptive_cursor(list);
+    for (size_t i = 0; i < count; i++, adaptive_cursor_next(&cursor)) {
+        assert(*(int *)adaptive_cursor_get(&cursor) == values[i]);
+    }
+    assert(adaptive_cursor_get(&cursor) == NULL);
+    if (count > 0) {
+        assert(*(int *)adaptive_get_at_position(list, (int)(count / 2)) == values[count / 2]);
+    }
+}
+
+// 测试28：自适应链表
+void test_adaptive_list() {
+    printf("\n=== 测试28：自适应链表 ===\n");
+
+    // 三种表示固定后执行同一串随机操作，与参照数组逐步对比
+    const char *names[] = {"链表", "环形缓冲区", "分块数组"};
+    for (int repr = 0; repr < ADAPTIVE_REPR_COUNT; repr++) {
+        AdaptiveList *list = adaptive_list_create(int_cmp, int_free);
+        assert(adaptive_list_convert(list, (AdaptiveRepr)repr));
+        adaptive_list_set_adaptive(list, false);
+
+        int *expected = malloc(3000 * sizeof(int));
+        size_t count = 0;
+        unsigned int seed = 7;
+        for (int step = 0; step < 3000; step++) {
+            seed = seed * 1103515245 + 12345;
+            int op = (seed >> 16) % 8;
+            size_t position = count ? (seed >> 4) % (count + 1) : 0;
+            if (op <= 1) {
+                adaptive_insert_at_tail(list, new_int(step));
+                expected[count++] = step;
+            } else if (op == 2) {
+                adaptive_insert_at_head(list, new_int(step));
+                memmove(expected + 1, expected, count++ * sizeof(int));
+                expected[0] = step;
+            } else if (op <= 4) {
+                adaptive_insert_at_position(list, new_int(step), (int)position);
+                memmove(expected + position + 1, expected + position, (count++ - position) * sizeof(int));
+                expected[position] = step;
+            } else if (count > 0 && op == 5) {
+                if (position == count) position--;
+                adaptive_delete_at_position(list, (int)position);
+                memmove(expected + position, expected + position + 1, (--count - position) * sizeof(int));
+            } else if (count > 0 && op == 6) {
+                adaptive_delete_at_head(list);
+                memmove(expected, expected + 1, --count * sizeof(int));
+            } else if (count > 0) {
+                int key = expected[position == count ? 0 : position];
+                size_t at = position == count ? 0 : position;
+                for (size_t i = 0; i < at; i++) {
+                    if (expected[i] == key) at = i;
+                }
+                assert(adaptive_delete_by_value(list, &key));
+                memmove(expected + at, expected + at + 1, (--count - at) * sizeof(int));
+            }
+        }
+        assert_adaptive_ints(list, expected, count);
+        int key = expected[count / 3];
+        assert(*(int *)adaptive_search_by_value(list, &key) == key);
+        int value = -1;
+        assert(adaptive_update_by_value(list, &key, &value, int_update));
+        expected[count / 3] = -1;
+        key = 100000;
+        assert(adaptive_search_by_value(list, &key) == NULL);
+        assert(adaptive_list_repr(list) == (AdaptiveRepr)repr && list->migrations <= 1);
+
+        // 游标：删除偶数，在每个 3 的倍数之前插入它的相反数
+        AdaptiveCursor cursor = adaptive_cursor(list);
+        int *edited = malloc(2 * 3000 * sizeof(int));
+        size_t kept = 0;
+        for (size_t i = 0; i < count; i++) {
+            int current = *(int *)adaptive_cursor_get(&cursor);
+            assert(current == expected[i]);
+            if (current % 2 == 0) {
+                assert(adaptive_cursor_remove(&cursor));
+                continue;
+            }
+            if (current % 3 == 0) {
+                assert(adaptive_cursor_insert(&cursor, new_int(-current)));
+                assert(*(int *)adaptive_cursor_get(&cursor) == current);
+                edited[kept++] = -current;
+            }
+            edited[kept++] = current;
+            adaptive_cursor_next(&cursor);
+        }
+        assert(adaptive_cursor_get(&cursor) == NULL);
+        assert(adaptive_cursor_insert(&cursor, new_int(123456)));
+        edited[kept++] = 123456;
+        assert_adaptive_ints(list, edited, kept);
+
+        // 任意两种表示之间迁移，顺序与数据指针不变
+        void *first = adaptive_get_at_position(list, 0);
+        for (int to = 0; to < ADAPTIVE_REPR_COUNT; to++) {
+            assert(adaptive_list_convert(list, (AdaptiveRepr)to));
+            assert_adaptive_ints(list, edited, kept);
+            assert(adaptive_get_at_position(list, 0) == first);
+        }
+
+        adaptive_clear(list);
+        assert(adaptive_is_empty(list) && adaptive_delete_at_tail(list) == false);
+        printf("✓ %s表示：随机插入删除、按值操作、游标编辑、迁移后内容一致\n", names[repr]);
+        free(edited);
+        free(expected);
+        adaptive_list_destroy(list);
+    }
+
+    // 操作分布变化时迁移到对应的表示
+    AdaptiveList *list = adaptive_list_create(int_cmp, int_free);
+    for (int i = 0; i < 20000; i++) {
+        adaptive_insert_at_tail(list, new_int(i));
+        adaptive_delete_at_head(list);
+        adaptive_insert_at_tail(list, new_int(i));
+    }
+    assert(adaptive_list_repr(list) == ADAPTIVE_RING);
+
+    unsigned int seed = 11;
+    for (int i = 0; i < 20000; i++) {
+        seed = seed * 1103515245 + 12345;
+        int position = (int)((seed >> 8) % adaptive_get_length(list));
+        adaptive_insert_at_position(list, new_int(i), position);
+        adaptive_delete_at_position(list, position / 2 + 1);
+    }
+    assert(adaptive_list_repr(list) == ADAPTIVE_CHUNKED);
+
+    for (int round = 0; round < 4; round++) {
+        AdaptiveCursor cursor = adaptive_cursor(list);
+        while (adaptive_cursor_get(&cursor)) {
+            adaptive_cursor_insert(&cursor, new_int(round));
+            adaptive_cursor_remove(&cursor);
+        }
+    }
+    assert(adaptive_list_repr(list) == ADAPTIVE_LINKED);
+    assert(adaptive_get_length(list) == 20000 && list->migrations == 3);
+    printf("✓ 队列 -> 环形缓冲区，按位置编辑 -> 分块数组，游标密集编辑 -> 链表\n");
+
+    // 滞后：两种分布交替出现时不会每次都迁移
+    size_t migrations = list->migrations;
+    for (int burst = 0; burst < 40; burst++) {
+        for (int i = 0; i < 100; i++) {
+            adaptive_insert_at_tail(list, new_int(i));
+            adaptive_delete_at_head(list);
+        }
+        for (int i = 0; i < 100; i++) {
+            int key = -1;
+            adaptive_search_by_value(list, &key);
+        }
+    }
+    assert(list->migrations - migrations <= 2);
+    printf("✓ 交替负载下迁移%zu次\n", list->migrations - migrations);
+    adaptive_list_destroy(list);
+
+    // 耗时：固定为链表 vs 自适应
+    const char *workloads[] = {"队列", "按位置读取", "按位置编辑"};
+    for (int w = 0; w < 3; w++) {
+        double elapsed[2];
+        for (int adaptive = 0; adaptive < 2; adaptive++) {
+            AdaptiveList *bench = adaptive_list_create(int_cmp, int_free);
+            if (!adaptive) adaptive_list_set_adaptive(bench, false);
+            for (int i = 0; i < 10000; i++) {
+                adaptive_insert_at_tail(bench, new_int(i));
+            }
+            seed = 3;
+            clock_t start = clock();
+            for (int i = 0; i < 20000; i++) {
+                seed = seed * 1103515245 + 12345;
+                int position = (int)((seed >> 8) % adaptive_get_length(bench));
+                if (w == 0) {
+                    adaptive_insert_at_tail(bench, new_int(i));
+                    adaptive_delete_at_head(bench);
+                } else if (w == 1) {
+                    adaptive_get_at_position(bench, position);
+                } else {
+                    adaptive_insert_at_position(bench, new_int(i), position);
+                    adaptive_delete_at_position(bench, position);
+                }
+            }
+            elapsed[adaptive] = (double)(clock() - start) / CLOCKS_PER_SEC;
+            adaptive_list_destroy(bench);
+        }
+        printf("10000个元素%s2万次: 固定链表 %.4f秒, 自适应 %.4f秒\n", workloads[w], elapsed[0], elapsed[1]);
+    }
+}
+
+static void sum_id(int64_t id, void *ctx) {
+    *(int64_t *)ctx += id;
+}
+
+void test_id_list() {
+    printf("\n=== 测试29：压缩 ID 链表 ===\n");
+
+    // 间隔 1~1000 的递增 ID，与参照数组对比
+    IdList *list = id_list_create();
+    size_t count = 20000;
+    int64_t *expected = malloc(count * sizeof(int64_t));
+    int64_t id = -5000000;
+    unsigned int seed = 11;
+    for (size_t i = 0; i < count; i++) {
+        seed = seed * 1103515245 + 12345;
+        id += 1 + (seed >> 16) % 1000;
+        expected[i] = id;
+        assert(id_list_append(list, id));
+    }
+    assert(!id_list_append(list, id));
+    assert(!id_list_append(list, id - 1));
+    assert(id_list_size(list) == count);
+
+    IdIterator it = id_list_begin(list);
+    size_t index = 0;
+    while (id_list_next(&it, &id)) {
+        assert(id == expected[index++]);
+    }
+    assert(index == count);
+    for (size_t i = 0; i < count; i++) {
+        assert(id_list_contains(list, expected[i]));
+        assert(!id_list_contains(list, expected[i] + 1) || (i + 1 < count && expected[i + 1] == expected[i] + 1));
+    }
+    assert(!id_list_contains(list, expected[0] - 1));
+    assert(!id_list_contains(list, expected[count - 1] + 1));
+    printf("✓ 追加、遍历、查找正确，%zu个ID共%zu字节\n", count, id_list_memory(list));
+
+    // 删除：每隔一个删，再删光若干整块，剩余部分仍与参照一致
+    for (size_t i = 0; i < count; i += 2) {
+        assert(id_list_delete(list, expected[i]));
+        assert(!id_list_delete(list, expected[i]));
+    }
+    for (size_t i = 1; i < 4000; i += 2) {
+        assert(id_list_delete(list, expected[i]));
+    }
+    size_t blocks = list->block_count;
+    assert(blocks <= (count / 2 - 2000 + ID_BLOCK_COUNT - 1) / ID_BLOCK_COUNT * 2);
+    int64_t sum = 0;
+    int64_t expected_sum = 0;
+    for (size_t i = 4001; i < count; i += 2) {
+        expected_sum += expected[i];
+        assert(id_list_contains(list, expected[i]));
+        assert(!id_list_contains(list, expected[i - 1]));
+    }
+    assert(id_list_for_each(list, sum_id, &sum) == count / 2 - 2000);
+    assert(sum == expected_sum);
+    // 删除后仍可在末尾追加
+    assert(id_list_append(list, expected[count - 1] + 7));
+    assert(id_list_contains(list, expected[count - 1] + 7));
+    printf("✓ 删除与块合并正确，剩余%zu个ID、%zu块\n", id_list_size(list), blocks);
+    id_list_destroy(list);
+
+    // 位宽增长与极值：差值跨越整个 int64 范围
+    list = id_list_create();
+    int64_t extremes[] = {INT64_MIN, INT64_MIN + 1, -1, 0, 1, 3, 1000, INT64_MAX - 1, INT64_MAX};
+    size_t extreme_count = sizeof(extremes) / sizeof(extremes[0]);
+    for (size_t i = 0; i < extreme_count; i++) {
+        assert(id_list_append(list, extremes[i]));
+    }
+    it = id_list_begin(list);
+    index = 0;
+    while (id_list_next(&it, &id)) {
+        assert(id == extremes[index++]);
+    }
+    assert(index == extreme_count);
+    assert(id_list_delete(list, 0));
+    assert(id_list_delete(list, INT64_MAX - 1));
+    assert(id_list_contains(list, INT64_MAX) && id_list_contains(list, INT64_MIN));
+    assert(!id_list_contains(list, 0) && id_list_size(list) == extreme_count - 2);
+    while (id_list_size(list) > 0) {
+        it = id_list_begin(list);
+        assert(id_list_next(&it, &id) && id_list_delete(list, id));
+    }
+    assert(list->block_count == 0);
+    assert(id_list_append(list, 42) && id_list_contains(list, 42));
+    id_list_destroy(list);
+    printf("✓ 位宽增长、int64 极值与删空后重用正确\n");
+
+    // 内存与遍历耗时：连续 ID 与间隔较大的 ID，对比每个 ID 单独 malloc 的 List
+    const char *patterns[] = {"连续", "间隔1~1000"};
+    for (int pattern = 0; pattern < 2; pattern++) {
+        size_t n = 1000000;
+        IdList *ids = id_list_create();
+        List *baseline = init_list(NULL, free);
+        seed = 5;
+        id = 0;
+        for (size_t i = 0; i < n; i++) {
+            seed = seed * 1103515245 + 12345;
+            id += pattern == 0 ? 1 : 1 + (seed >> 16) % 1000;
+            id_list_append(ids, id);
+            int64_t *data = malloc(sizeof(int64_t));
+            *data = id;
+            insert_at_tail(baseline, data);
+        }
+        double per_id = (double)id_list_memory(ids) / n;
+        assert(per_id < 4.0);
+
+        clock_t start = clock();
+        int64_t id_sum = 0;
+        it = id_list_begin(ids);
+        while (id_list_next(&it, &id)) {
+            id_sum += id;
+        }
+        double id_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+        start = clock();
+        int64_t list_sum = 0;
+        for (ListNode *node = get_first_node(baseline); node; node = get_next_node(baseline, node)) {
+            list_sum += *(int64_t *)node->data;
+        }
+        double list_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+        assert(id_sum == list_sum);
+
+        printf("100万个%s ID: 每个%.2f字节（List 约%zu字节），遍历 %.4f秒 vs List %.4f秒\n", patterns[pattern],
+               per_id, sizeof(ListNode) + sizeof(int64_t), id_time, list_time);
+        id_list_destroy(ids);
+        destroy_list(baseline);
+    }
+    free(expected);
+}
+
 int main() {
     printf("开始全面测试双向链表实现...\n");
     
@@ -608,6 +3238,26 @@ int main() {
     test_edge_cases();
     test_performance();
     test_comprehensive();
+    test_timer_wheel();
+    test_lru_cache();
+    test_copy_and_clone();
+    test_fingerprint_compare();
+    test_trace_replay();
+    test_paged_list();
+    test_sharded_list();
+    test_ws_deque();
+    test_filter();
+    test_radix_sort();
+    test_set_operations();
+    test_compact_list();
+    test_lazy_reverse();
+    test_shm_list();
+    test_journal();
+    test_pipeline();
+    test_batch_cmp();
+    test_deferred_delete();
+    test_adaptive_list();
+    test_id_list();
     
     printf("\n================================\n");
     printf("所有测试通过！链表实现正确。\n");